@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Long cross-country newRoute queries for timing the map program.
+
+usage: cross_country.py grid SIDE QUERIES
+       cross_country.py geo CITIES QUERIES [--uniform]
+
+grid  SIDE x SIDE grid with random lengths; each query joins a city in the
+      leftmost fifth with one in the rightmost fifth
+geo   sparse planar graph: CITIES random points, each joined to its 3 nearest
+      neighbours with Euclidean lengths; queries join cities in the leftmost
+      and rightmost 15% (or uniformly random cities with --uniform)
+
+Every query is a newRoute;1 followed by removeRoute;1, so the output is
+empty and the run time is dominated by the searches.
+"""
+import math
+import random
+import sys
+
+
+def grid(side, queries, rng):
+    lines = []
+    for i in range(side):
+        for j in range(side):
+            if j + 1 < side:
+                lines.append("addRoad;c%d_%d;c%d_%d;%d;%d" % (
+                    i, j, i, j + 1, rng.randint(1, 10 ** 6),
+                    rng.randint(1900, 2020)))
+            if i + 1 < side:
+                lines.append("addRoad;c%d_%d;c%d_%d;%d;%d" % (
+                    i, j, i + 1, j, rng.randint(1, 10 ** 6),
+                    rng.randint(1900, 2020)))
+    for _ in range(queries):
+        start = (rng.randrange(side // 5), rng.randrange(side))
+        final = (side - 1 - rng.randrange(side // 5), rng.randrange(side))
+        lines.append("newRoute;1;c%d_%d;c%d_%d" % (start + final))
+        lines.append("removeRoute;1")
+    return lines
+
+
+def geo(cities, queries, uniform, rng):
+    size = int(math.sqrt(cities)) * 100
+    points = [(rng.uniform(0, size), rng.uniform(0, size))
+              for _ in range(cities)]
+    cells = {}
+    for i, (x, y) in enumerate(points):
+        cells.setdefault((int(x // 100), int(y // 100)), []).append(i)
+
+    lines = []
+    seen = set()
+    for i, (x, y) in enumerate(points):
+        cx, cy = int(x // 100), int(y // 100)
+        near = []
+        for dx in (-1, 0, 1):
+            for dy in (-1, 0, 1):
+                for j in cells.get((cx + dx, cy + dy), []):
+                    if j != i:
+                        near.append((math.hypot(points[j][0] - x,
+                                                points[j][1] - y), j))
+        near.sort()
+        for distance, j in near[:3]:
+            edge = (min(i, j), max(i, j))
+            if edge in seen:
+                continue
+            seen.add(edge)
+            lines.append("addRoad;m%d;m%d;%d;%d" % (
+                i, j, int(distance * 1000) + 1, rng.randint(1900, 2020)))
+
+    for _ in range(queries):
+        while True:
+            start, final = rng.randrange(cities), rng.randrange(cities)
+            if uniform or (points[start][0] < size * 0.15 and
+                           points[final][0] > size * 0.85):
+                break
+        lines.append("newRoute;1;m%d;m%d" % (start, final))
+        lines.append("removeRoute;1")
+    return lines
+
+
+def main():
+    if len(sys.argv) < 4 or sys.argv[1] not in ("grid", "geo"):
+        sys.exit(__doc__)
+    rng = random.Random(18)
+    count, queries = int(sys.argv[2]), int(sys.argv[3])
+    if sys.argv[1] == "grid":
+        lines = grid(count, queries, rng)
+    else:
+        lines = geo(count, queries, "--uniform" in sys.argv[4:], rng)
+    sys.stdout.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
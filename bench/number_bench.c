@@ -0,0 +1,115 @@
+// Mierzy czas sprawdzania i zamiany na liczby pól długości i roku budowy
+// w wierszach definicji dróg krajowych.
+// Użycie: number_bench plik_z_wierszami [liczba_przebiegów]
+// Wiersze są dzielone na pola raz, a mierzone są tylko kolejne przebiegi
+// funkcji strGetLength i strGetYear po wszystkich polach liczbowych.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "line_fields.h"
+#include "strings.h"
+
+#define BEST_OF 7  ///< liczba pomiarów, z których wybierany jest najlepszy
+
+// Wczytuje cały plik @p path do pamięci, zakończony znakiem '\0'.
+static char *readFile(const char *path, size_t *size) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    return NULL;
+  }
+
+  size_t capacity = 1 << 20;
+  char *data = (char *)malloc(capacity);
+  *size = 0;
+  size_t count;
+  while (data != NULL &&
+         (count = fread(data + *size, 1, capacity - *size - 1, file)) > 0) {
+    *size += count;
+    if (*size + 1 == capacity) {
+      capacity *= 2;
+      char *larger = (char *)realloc(data, capacity);
+      if (larger == NULL) {
+        free(data);
+      }
+      data = larger;
+    }
+  }
+  fclose(file);
+  if (data != NULL) {
+    data[*size] = '\0';
+  }
+  return data;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s lines.txt [passes]\n", argv[0]);
+    return 1;
+  }
+  int passes = argc > 2 ? atoi(argv[2]) : 10;
+
+  size_t size;
+  char *data = readFile(argv[1], &size);
+  LineFields *fields = newLineFields();
+  if (data == NULL || fields == NULL) {
+    fprintf(stderr, "cannot read %s\n", argv[1]);
+    return 1;
+  }
+
+  // pola długości i roku budowy: pozycje 2 i 3 każdej trójki po numerze
+  size_t count = 0, capacity = 1024;
+  const char **numbers = (const char **)malloc(capacity * sizeof(char *));
+  char *line = data;
+  while (numbers != NULL && line < data + size) {
+    char *newline = strchr(line, '\n');
+    size_t length = newline != NULL ? (size_t)(newline - line) : strlen(line);
+    line[length] = '\0';
+    if (!splitLine(fields, line, length)) {
+      return 1;
+    }
+    for (size_t i = 2; i + 1 < fields->count; i += 3) {
+      if (count + 2 > capacity) {
+        capacity *= 2;
+        numbers = (const char **)realloc(numbers, capacity * sizeof(char *));
+        if (numbers == NULL) {
+          break;
+        }
+      }
+      numbers[count++] = fields->fields[i].chars;
+      numbers[count++] = fields->fields[i + 1].chars;
+    }
+    line += length + 1;
+  }
+  if (numbers == NULL) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  double best = -1;
+  unsigned long long sum = 0;
+  for (int r = 0; r < BEST_OF; r++) {
+    clock_t start = clock();
+    for (int pass = 0; pass < passes; pass++) {
+      for (size_t i = 0; i < count; i += 2) {
+        sum += strGetLength(numbers[i]);
+        sum += (unsigned)strGetYear(numbers[i + 1]);
+      }
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    if (best < 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+
+  printf("%zu numeric fields, %d passes\n", count, passes);
+  printf("best of %d: %.3f s (checksum %llu)\n", BEST_OF, best, sum);
+
+  free(numbers);
+  deleteLineFields(fields);
+  free(data);
+  return 0;
+}
@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+"""Realistic route-definition lines for number_bench and the map program.
+
+usage: route_lines.py LINES [CITIES]
+
+Each line defines route 1 through CITIES (20 by default) cities with
+lengths 1..5000 and years 1950..2024. The last year is 0, so the map
+program parses every number of the line and then rejects it, and the
+same route id can be reused on every line.
+"""
+import random
+import sys
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    count = int(sys.argv[1])
+    cities = int(sys.argv[2]) if len(sys.argv) > 2 else 20
+    rng = random.Random(23)
+    lines = []
+    for _ in range(count):
+        parts = ["1"]
+        for i in range(cities):
+            parts.append("Miasto %d" % rng.randrange(10 ** 5))
+            if i + 1 < cities:
+                parts.append(str(rng.randint(1, 5000)))
+                parts.append(str(rng.randint(1950, 2024)))
+        parts[-2] = "0"
+        lines.append(";".join(parts))
+    sys.stdout.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,117 @@
+// Mierzy czas wstawiania nazw miast do drzewa trie i wyszukiwania ich.
+// Użycie: trie_bench plik_z_nazwami [liczba_powtórzeń]
+// Plik zawiera po jednej nazwie w wierszu. Wypisuje najlepszy czas
+// wstawienia wszystkich nazw i najlepszy czas 10 przebiegów wyszukiwania.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "node_pool.h"
+#include "trie.h"
+
+#define LOOKUP_PASSES 10  ///< liczba przebiegów wyszukiwania
+
+// Wczytuje wszystkie wiersze pliku @p path. Zwraca liczbę nazw lub -1.
+static int readNames(const char *path, char ***names, size_t *bytes) {
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    return -1;
+  }
+
+  int count = 0, capacity = 1024;
+  *names = (char **)malloc(capacity * sizeof(char *));
+  *bytes = 0;
+  char line[4096];
+  while (*names != NULL && fgets(line, sizeof(line), file) != NULL) {
+    line[strcspn(line, "\n")] = '\0';
+    if (count == capacity) {
+      capacity *= 2;
+      *names = (char **)realloc(*names, capacity * sizeof(char *));
+      if (*names == NULL) {
+        break;
+      }
+    }
+    size_t length = strlen(line);
+    (*names)[count] = (char *)malloc(length + 1);
+    if ((*names)[count] == NULL) {
+      break;
+    }
+    memcpy((*names)[count++], line, length + 1);
+    *bytes += length;
+  }
+  fclose(file);
+  return *names == NULL ? -1 : count;
+}
+
+static double secondsSince(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s names.txt [repeats]\n", argv[0]);
+    return 1;
+  }
+  int repeats = argc > 2 ? atoi(argv[2]) : 9;
+
+  char **names;
+  size_t bytes;
+  int count = readNames(argv[1], &names, &bytes);
+  if (count <= 0) {
+    fprintf(stderr, "cannot read names from %s\n", argv[1]);
+    return 1;
+  }
+
+  double bestInsert = -1, bestLookup = -1;
+  for (int r = 0; r < repeats; r++) {
+    NodePools *pools = newNodePools();
+    Trie *root = pools != NULL ? newTrieNode(pools) : NULL;
+    if (root == NULL) {
+      fprintf(stderr, "out of memory\n");
+      return 1;
+    }
+
+    clock_t start = clock();
+    for (int i = 0; i < count; i++) {
+      if (insertStr(pools, root, names[i], i) == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+      }
+    }
+    double insert = secondsSince(start);
+
+    start = clock();
+    int found = 0;
+    for (int pass = 0; pass < LOOKUP_PASSES; pass++) {
+      for (int i = 0; i < count; i++) {
+        found += getNodePtr(root, names[i]) != NULL;
+      }
+    }
+    double lookup = secondsSince(start);
+    if (found != LOOKUP_PASSES * count) {
+      fprintf(stderr, "lookup failed\n");
+      return 1;
+    }
+
+    if (bestInsert < 0 || insert < bestInsert) {
+      bestInsert = insert;
+    }
+    if (bestLookup < 0 || lookup < bestLookup) {
+      bestLookup = lookup;
+    }
+    deleteNodePools(pools);
+  }
+
+  printf("%d names, %.1f bytes on average\n", count, (double)bytes / count);
+  printf("insert  %.3f s\n", bestInsert);
+  printf("lookups %.3f s (%d passes)\n", bestLookup, LOOKUP_PASSES);
+
+  for (int i = 0; i < count; i++) {
+    free(names[i]);
+  }
+  free(names);
+  return 0;
+}
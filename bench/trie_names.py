@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+"""City names for trie_bench and for peak-RSS runs of the map program.
+
+usage: trie_names.py prefix|grid [--roads]
+
+prefix  ~300k names sharing long prefixes, like "Nowa Huta nad Wisla 123456"
+grid    490000 short names "c<i>_<j>" of a 700x700 grid
+--roads print addRoad commands joining consecutive names instead of the
+        names, so the full program loads the same set of cities
+"""
+import random
+import sys
+
+PREFIXES = ["Nowa Huta nad Wisla", "Stara Wies Gorna", "Stara Wies Dolna",
+            "Wola Kosnowa", "Wola Rafalowska", "Zielona Gora Wschod",
+            "Nowe Miasto nad Pilica", "Nowe Miasto Lubawskie",
+            "Kamien Pomorski", "Kamienna Gora"]
+
+
+def names(kind):
+    if kind == "grid":
+        return ["c%d_%d" % (i, j) for i in range(700) for j in range(700)]
+    rng = random.Random(9)
+    unique = {"%s %d" % (rng.choice(PREFIXES), rng.randrange(10 ** 6))
+              for _ in range(300000)}
+    result = sorted(unique)
+    rng.shuffle(result)
+    return result
+
+
+def main():
+    if len(sys.argv) < 2 or sys.argv[1] not in ("prefix", "grid"):
+        sys.exit(__doc__)
+    result = names(sys.argv[1])
+    if "--roads" in sys.argv[2:]:
+        lines = ["addRoad;%s;%s;1;2000" % (result[i], result[i + 1])
+                 for i in range(len(result) - 1)]
+    else:
+        lines = result
+    sys.stdout.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,134 @@
+#include "byte_scan.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "defines.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BYTE_SCAN_X86
+#include <immintrin.h>
+#endif
+
+/** @brief Funkcja wyznaczająca maski średników i znaków sterujących.
+ * @param[in] line        – wskaźnik na wiersz;
+ * @param[in] length      – długość wiersza;
+ * @param[out] semicolons – tablica masek średników;
+ * @param[out] controls   – tablica masek znaków sterujących.
+ */
+typedef void (*ScanFunction)(const char *line, size_t length,
+                             uint32_t *semicolons, uint32_t *controls);
+
+// Wyznacza maski bloków od @p block do końca wiersza, bajt po bajcie.
+static void scanTail(const char *line, size_t length, size_t block,
+                     uint32_t *semicolons, uint32_t *controls) {
+  for (size_t begin = block * SCAN_BLOCK_SIZE; begin < length;
+       begin += SCAN_BLOCK_SIZE, block++) {
+    size_t end = length - begin < SCAN_BLOCK_SIZE ? length
+                                                  : begin + SCAN_BLOCK_SIZE;
+    uint32_t semicolonMask = 0, controlMask = 0;
+    for (size_t i = begin; i < end; i++) {
+      unsigned char byte = (unsigned char)line[i];
+      semicolonMask |= (uint32_t)(byte == ';') << (i - begin);
+      controlMask |= (uint32_t)(byte < 32) << (i - begin);
+    }
+    semicolons[block] = semicolonMask;
+    controls[block] = controlMask;
+  }
+}
+
+// Wyznacza maski całego wiersza bajt po bajcie.
+static void scanScalar(const char *line, size_t length, uint32_t *semicolons,
+                       uint32_t *controls) {
+  scanTail(line, length, 0, semicolons, controls);
+}
+
+#ifdef BYTE_SCAN_X86
+// Maksimum bajtu i 31 jest równe 31 dokładnie wtedy, gdy bajt bez znaku
+// jest mniejszy niż 32.
+__attribute__((target("sse2"))) static void scanSse2(const char *line,
+                                                     size_t length,
+                                                     uint32_t *semicolons,
+                                                     uint32_t *controls) {
+  const __m128i semicolon = _mm_set1_epi8(';');
+  const __m128i limit = _mm_set1_epi8(31);
+
+  size_t blocks = length / SCAN_BLOCK_SIZE;
+  for (size_t i = 0; i < blocks; i++) {
+    const char *block = line + i * SCAN_BLOCK_SIZE;
+    __m128i low = _mm_loadu_si128((const __m128i *)block);
+    __m128i high = _mm_loadu_si128((const __m128i *)(block + 16));
+
+    uint32_t lowSemicolons =
+        (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(low, semicolon));
+    uint32_t highSemicolons =
+        (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(high, semicolon));
+    uint32_t lowControls = (uint32_t)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_max_epu8(low, limit), limit));
+    uint32_t highControls = (uint32_t)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_max_epu8(high, limit), limit));
+
+    semicolons[i] = lowSemicolons | highSemicolons << 16;
+    controls[i] = lowControls | highControls << 16;
+  }
+  scanTail(line, length, blocks, semicolons, controls);
+}
+
+__attribute__((target("avx2"))) static void scanAvx2(const char *line,
+                                                     size_t length,
+                                                     uint32_t *semicolons,
+                                                     uint32_t *controls) {
+  const __m256i semicolon = _mm256_set1_epi8(';');
+  const __m256i limit = _mm256_set1_epi8(31);
+
+  size_t blocks = length / SCAN_BLOCK_SIZE;
+  for (size_t i = 0; i < blocks; i++) {
+    __m256i bytes =
+        _mm256_loadu_si256((const __m256i *)(line + i * SCAN_BLOCK_SIZE));
+    semicolons[i] =
+        (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, semicolon));
+    controls[i] = (uint32_t)_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, limit), limit));
+  }
+  scanTail(line, length, blocks, semicolons, controls);
+}
+#endif
+
+// Wybiera najszybszą wersję obsługiwaną przez procesor.
+static ScanFunction chooseScanFunction() {
+#ifdef BYTE_SCAN_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return scanAvx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return scanSse2;
+  }
+#endif
+  return scanScalar;
+}
+
+void scanLineMasks(const char *line, size_t length, uint32_t *semicolons,
+                   uint32_t *controls) {
+  static ScanFunction scan = NULL;
+  if (scan == NULL) {
+    scan = chooseScanFunction();
+  }
+  scan(line, length, semicolons, controls);
+}
+
+int lowestSetBit(uint32_t mask) {
+  assert(mask != 0);
+#ifdef __GNUC__
+  return __builtin_ctz(mask);
+#else
+  // mnożenie najmłodszego bitu przez ciąg de Bruijna daje w górnych pięciu
+  // bitach różną wartość dla każdej pozycji
+  static const int positions[32] = {0,  1,  28, 2,  29, 14, 24, 3,
+                                    30, 22, 20, 15, 25, 17, 4,  8,
+                                    31, 27, 13, 23, 21, 19, 16, 7,
+                                    26, 12, 18, 6,  11, 5,  10, 9};
+  return positions[((mask & (~mask + 1)) * 0x077CB531U) >> 27];
+#endif
+}
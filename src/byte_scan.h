@@ -0,0 +1,32 @@
+/** @file
+ * Interfejs wyszukiwania średników i znaków sterujących w wierszu
+ */
+
+#ifndef __BYTE_SCAN_H__
+#define __BYTE_SCAN_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Wyznacza maski średników i znaków sterujących w wierszu.
+ * Wiersz jest dzielony na bloki po @ref SCAN_BLOCK_SIZE bajtów, z których
+ * ostatni może być niepełny. Bit @p j elementu @p semicolons[i] jest
+ * ustawiony, jeśli bajt o numerze @p i * @ref SCAN_BLOCK_SIZE + @p j jest
+ * średnikiem, a bit elementu @p controls[i], jeśli ma on kod mniejszy niż
+ * 32. Przy pierwszym wywołaniu wybiera wersję korzystającą z AVX2 lub SSE2,
+ * jeśli procesor je obsługuje, a wpp. wersję przetwarzającą pojedyncze bajty.
+ * @param[in] line        – wskaźnik na wiersz;
+ * @param[in] length      – długość wiersza;
+ * @param[out] semicolons – tablica masek średników;
+ * @param[out] controls   – tablica masek znaków sterujących.
+ */
+void scanLineMasks(const char *line, size_t length, uint32_t *semicolons,
+                   uint32_t *controls);
+
+/** @brief Zwraca numer najmłodszego ustawionego bitu maski.
+ * @param[in] mask – niezerowa maska.
+ * @return Numer bitu, od 0 do 31.
+ */
+int lowestSetBit(uint32_t mask);
+
+#endif  // __BYTE_SCAN_H__
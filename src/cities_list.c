@@ -11,10 +11,10 @@ CitiesListElement makeNewCitiesListElem(void *city) {
   return elem;
 }
 
-CitiesListNode *makeNewCitiesListNode(CitiesListNode *prev,
+CitiesListNode *makeNewCitiesListNode(NodePools *pools, CitiesListNode *prev,
                                       CitiesListElement elem,
                                       CitiesListNode *next) {
-  CitiesListNode *node = (CitiesListNode *)malloc(sizeof(CitiesListNode));
+  CitiesListNode *node = (CitiesListNode *)allocNode(&pools->citiesNodes);
   if (node == NULL) {
     return NULL;
   }
@@ -26,31 +26,24 @@ CitiesListNode *makeNewCitiesListNode(CitiesListNode *prev,
   return node;
 }
 
-CitiesList *makeNewCitiesList() {
-  CitiesList *list = (CitiesList *)malloc(sizeof(CitiesList));
+CitiesList *makeNewCitiesList(NodePools *pools) {
+  CitiesList *list = (CitiesList *)allocNode(&pools->citiesLists);
   if (list == NULL) {
     return NULL;
   }
 
-  list->head = makeNewCitiesListNode(NULL, makeNewCitiesListElem(NULL), NULL);
-
-  if (list->head == NULL) {
-    free(list);
-    list = NULL;
-    return NULL;
-  }
-
-  list->tail =
-      makeNewCitiesListNode(list->head, makeNewCitiesListElem(NULL), NULL);
-
-  if (list->tail == NULL) {
-    free(list);
-    list = NULL;
-    return NULL;
-  }
+  list->pools = pools;
+  list->head = &list->sentinels[0];
+  list->tail = &list->sentinels[1];
 
+  list->head->prev = NULL;
+  list->head->elem = makeNewCitiesListElem(NULL);
   list->head->next = list->tail;
 
+  list->tail->prev = list->head;
+  list->tail->elem = makeNewCitiesListElem(NULL);
+  list->tail->next = NULL;
+
   return list;
 }
 
@@ -58,7 +51,8 @@ bool isValidCitiesListNode(CitiesListNode *node) {
   return node != NULL && node->next != NULL && node->prev != NULL;
 }
 
-void removeCitiesListNode(CitiesListNode *node) {
+void removeCitiesListNode(CitiesList *list, CitiesListNode *node) {
+  assert(list);
   assert(node);
   assert(node->next);
   assert(node->prev);
@@ -66,7 +60,7 @@ void removeCitiesListNode(CitiesListNode *node) {
   node->next->prev = node->prev;
   node->prev->next = node->next;
 
-  free(node);
+  freeNode(&list->pools->citiesNodes, node);
 }
 
 void popBackCitiesList(CitiesList *list) {
@@ -74,7 +68,7 @@ void popBackCitiesList(CitiesList *list) {
   assert(list->tail);
 
   if (isValidCitiesListNode(list->tail->prev)) {
-    removeCitiesListNode(list->tail->prev);
+    removeCitiesListNode(list, list->tail->prev);
   }
 }
 
@@ -83,7 +77,7 @@ void popFrontCitiesList(CitiesList *list) {
   assert(list->head);
 
   if (isValidCitiesListNode(list->head->next)) {
-    removeCitiesListNode(list->head->next);
+    removeCitiesListNode(list, list->head->next);
   }
 }
 
@@ -96,15 +90,13 @@ void deleteCitiesList(CitiesList *list) {
     popBackCitiesList(list);
   }
 
-  free(list->head);
-  free(list->tail);
-  free(list);
-  list = NULL;
+  freeNode(&list->pools->citiesLists, list);
 }
 
 bool addCitiesListNode(CitiesList *list, void *city) {
-  CitiesListNode *node = makeNewCitiesListNode(
-      list->tail->prev, makeNewCitiesListElem(city), list->tail);
+  CitiesListNode *node =
+      makeNewCitiesListNode(list->pools, list->tail->prev,
+                            makeNewCitiesListElem(city), list->tail);
   if (node == NULL) {
     return false;
   }
@@ -7,6 +7,8 @@
 
 #include <stdbool.h>
 
+#include "node_pool.h"
+
 /**
  * Element węzła listy miast.
  */
@@ -25,10 +27,13 @@ typedef struct CitiesListNode {
 
 /**
  * Lista miast, reprezentowana przez głowę i ogon.
+ * Głowa i ogon są przechowywane w samej strukturze listy.
  */
 typedef struct CitiesList {
-  CitiesListNode *head;  ///< wskaźnik na głowę listy
-  CitiesListNode *tail;  ///< wskaźnik na ogon listy
+  CitiesListNode *head;         ///< wskaźnik na głowę listy
+  CitiesListNode *tail;         ///< wskaźnik na ogon listy
+  CitiesListNode sentinels[2];  ///< wartownicy: głowa i ogon
+  NodePools *pools;             ///< pule listy i jej węzłów
 } CitiesList;
 
 /** @brief Tworzy nowy element węzła listy.
@@ -39,19 +44,22 @@ CitiesListElement makeNewCitiesListElem(void *city);
 
 /** @brief Tworzy nowy węzeł listy.
  * Tworzy nowy węzeł, którego sąsiadami są prev i next.
+ * @param[in] pools – wskaźnik na pule węzłów;
  * @param[in] prev – wskaźnik na poprzedni element w liście
  * @param[in] elem – element węzła;
  * @param[in] next – wskaźnik na następny element w liście.
  * @return Wskaźnik na węzeł.
  */
-CitiesListNode *makeNewCitiesListNode(CitiesListNode *prev,
+CitiesListNode *makeNewCitiesListNode(NodePools *pools, CitiesListNode *prev,
                                       CitiesListElement elem,
                                       CitiesListNode *next);
 
 /** @brief Tworzy nową listę.
- * @return Wskaźnik na listę.
+ * Lista i jej węzły są przydzielane z pul @p pools.
+ * @param[in] pools – wskaźnik na pule węzłów.
+ * @return Wskaźnik na listę lub NULL, gdy nie udało się zaalokować pamięci.
  */
-CitiesList *makeNewCitiesList();
+CitiesList *makeNewCitiesList(NodePools *pools);
 
 /** @brief Sprawdza, czy dany wierzchołek jest poprawnym wierzchołkiem listy.
  * @param[in] node - wskaźnik na dany wierzchołek
@@ -61,11 +69,11 @@ CitiesList *makeNewCitiesList();
 bool isValidCitiesListNode(CitiesListNode *node);
 
 /** @brief Usuwa węzeł listy.
- * Usuwa węzeł wskazywany przez @p node.
- * Nic nie robi, jeśli wskaźnik ten ma wartość NULL.
- * @param[in] node – wskaźnik na usuwany wierzchołek.
+ * Usuwa węzeł wskazywany przez @p node i zwraca go do puli listy.
+ * @param[in,out] list – wskaźnik na listę, do której należy węzeł;
+ * @param[in] node     – wskaźnik na usuwany wierzchołek.
  */
-void removeCitiesListNode(CitiesListNode *node);
+void removeCitiesListNode(CitiesList *list, CitiesListNode *node);
 
 /** @brief Usuwa ostatni węzeł listy.
  * Usuwa ostatni węzeł listy wskazywanej przez @p list.
@@ -0,0 +1,101 @@
+#include "city_names.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "defines.h"
+
+CityNames *newCityNames() {
+  CityNames *names = (CityNames *)malloc(sizeof(CityNames));
+  if (names == NULL) {
+    return NULL;
+  }
+
+  names->chars = NULL;
+  names->size = 0;
+  names->charsCapacity = 0;
+  names->offsets = NULL;
+  names->lengths = NULL;
+  names->numOfNames = 0;
+  names->namesCapacity = 0;
+  return names;
+}
+
+void deleteCityNames(CityNames *names) {
+  if (names == NULL) {
+    return;
+  }
+  free(names->chars);
+  free(names->offsets);
+  free(names->lengths);
+  free(names);
+}
+
+// Zapewnia miejsce na kolejną nazwę o długości @p length.
+static bool reserveCityName(CityNames *names, size_t length) {
+  if (names->size + length + 1 > names->charsCapacity) {
+    size_t capacity = names->charsCapacity > 0 ? names->charsCapacity
+                                               : INITIAL_CITY_NAMES_CAPACITY;
+    while (capacity < names->size + length + 1) {
+      capacity *= 2;
+    }
+
+    char *chars = (char *)realloc(names->chars, capacity * sizeof(char));
+    if (chars == NULL) {
+      return false;
+    }
+    names->chars = chars;
+    names->charsCapacity = capacity;
+  }
+
+  if (names->numOfNames == names->namesCapacity) {
+    int capacity = names->namesCapacity > 0 ? 2 * names->namesCapacity
+                                            : INITIAL_CITIES_CAPACITY;
+
+    size_t *offsets =
+        (size_t *)realloc(names->offsets, capacity * sizeof(size_t));
+    if (offsets == NULL) {
+      return false;
+    }
+    names->offsets = offsets;
+
+    int *lengths = (int *)realloc(names->lengths, capacity * sizeof(int));
+    if (lengths == NULL) {
+      return false;
+    }
+    names->lengths = lengths;
+    names->namesCapacity = capacity;
+  }
+  return true;
+}
+
+bool addCityName(CityNames *names, const char *city) {
+  assert(names);
+  assert(city);
+
+  size_t length = strlen(city);
+  if (!reserveCityName(names, length)) {
+    return false;
+  }
+
+  memcpy(names->chars + names->size, city, length + 1);
+  names->offsets[names->numOfNames] = names->size;
+  names->lengths[names->numOfNames] = (int)length;
+  names->numOfNames++;
+  names->size += length + 1;
+  return true;
+}
+
+const char *getCityName(CityNames *names, int id) {
+  assert(names);
+  assert(0 <= id && id < names->numOfNames);
+  return names->chars + names->offsets[id];
+}
+
+int getCityNameLength(CityNames *names, int id) {
+  assert(names);
+  assert(0 <= id && id < names->numOfNames);
+  return names->lengths[id];
+}
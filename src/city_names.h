@@ -0,0 +1,62 @@
+/** @file
+ * Interfejs spójnego zbioru nazw miast, indeksowanego numerami miast
+ */
+
+#ifndef __CITY_NAMES_H__
+#define __CITY_NAMES_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Nazwy miast zapisane jedna za drugą w jednej tablicy znaków. Każda nazwa
+ * jest zakończona znakiem '\0'. Nazwa miasta o numerze @p id zaczyna się
+ * w miejscu @p offsets[id] i ma długość @p lengths[id].
+ */
+typedef struct CityNames {
+  char *chars;           ///< tablica znaków wszystkich nazw
+  size_t size;           ///< liczba zajętych znaków tablicy @p chars
+  size_t charsCapacity;  ///< rozmiar tablicy @p chars
+  size_t *offsets;       ///< początki nazw, indeksowane numerami miast
+  int *lengths;          ///< długości nazw, indeksowane numerami miast
+  int numOfNames;        ///< liczba zapisanych nazw
+  int namesCapacity;     ///< rozmiar tablic @p offsets i @p lengths
+} CityNames;
+
+/** @brief Tworzy nową, pustą strukturę.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci.
+ */
+CityNames *newCityNames();
+
+/** @brief Usuwa strukturę.
+ * Nic nie robi, jeśli wskaźnik @p names ma wartość NULL.
+ * @param[in] names – wskaźnik na usuwaną strukturę.
+ */
+void deleteCityNames(CityNames *names);
+
+/** @brief Dodaje nazwę kolejnego miasta.
+ * Nazwa otrzymuje numer równy liczbie wcześniej dodanych nazw.
+ * @param[in,out] names – wskaźnik na strukturę;
+ * @param[in] city      – wskaźnik na napis reprezentujący nazwę miasta.
+ * @return Wartość @p true, jeśli się udało.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+bool addCityName(CityNames *names, const char *city);
+
+/** @brief Zwraca nazwę miasta o numerze @p id.
+ * Wskaźnik przestaje być poprawny po dodaniu kolejnej nazwy.
+ * @param[in] names – wskaźnik na strukturę;
+ * @param[in] id    – numer miasta.
+ * @return Wskaźnik na napis zakończony znakiem '\0'.
+ */
+const char *getCityName(CityNames *names, int id);
+
+/** @brief Zwraca długość nazwy miasta o numerze @p id.
+ * @param[in] names – wskaźnik na strukturę;
+ * @param[in] id    – numer miasta.
+ * @return Długość nazwy.
+ */
+int getCityNameLength(CityNames *names, int id);
+
+#endif  // __CITY_NAMES_H__
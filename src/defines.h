@@ -12,5 +12,28 @@
 #define MAX_LENGTH 4294967295     ///< maksymalna dopuszczalna wartość length
 #define INF 2147483647            ///< maksymalna wartość int
 #define UNSIGNED_INF 4294967295U  ///< maksymalna wartość unsigned
+#define NO_CITY (-1)              ///< numer oznaczający brak miasta
+
+#define INITIAL_HEAP_CAPACITY 32         ///< początkowy rozmiar kopca
+#define INITIAL_GRAPH_CAPACITY 32        ///< początkowy rozmiar tablic grafu
+#define INITIAL_CITIES_CAPACITY 32       ///< początkowy rozmiar tablicy miast
+#define INITIAL_ROADS_INDEX_CAPACITY 32  ///< początkowy rozmiar indeksu dróg
+#define INITIAL_CITY_NAMES_CAPACITY 256  ///< początkowy rozmiar tablicy nazw
+#define ROADS_INDEX_THRESHOLD 8          ///< próg stopnia dla indeksu dróg
+#define INITIAL_SLAB_LENGTH 32           ///< liczba węzłów w pierwszym bloku
+#define MAX_SLAB_LENGTH 4096             ///< maksymalna liczba węzłów w bloku
+#define TRIE_INLINE_CHILDREN 4           ///< liczba dzieci w samym węźle
+#define TRIE_INDEXED_CHILDREN 48         ///< liczba dzieci w węźle z indeksem
+#define TRIE_INLINE_LABEL 8              ///< długość etykiety w samym węźle
+#define TRIE_TABLE_SIZE 256              ///< rozmiar tablicy dzieci węzła
+#define ROUTE_WRITER_CHUNK 512           ///< rozmiar bufora zapisu opisu
+#define MAX_NUMBER_LENGTH 10             ///< liczba cyfr największej liczby
+#define INITIAL_ROUTE_CAPACITY 16        ///< początkowy rozmiar drogi krajowej
+#define INITIAL_MEMBERS_CAPACITY 16      ///< początkowy rozmiar zbioru miast
+#define READ_BLOCK_SIZE 65536            ///< rozmiar bloku wczytywanego wejścia
+#define INITIAL_FIELDS_CAPACITY 32       ///< początkowa liczba pól wiersza
+#define SCAN_BLOCK_SIZE 32               ///< liczba bajtów opisana jedną maską
+#define INITIAL_SCAN_BLOCKS 64           ///< początkowa liczba masek wiersza
+#define OUTPUT_BUFFER_SIZE 65536         ///< rozmiar bufora wyjścia
 
 #endif  // __DEFINES_H__
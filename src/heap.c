@@ -0,0 +1,113 @@
+#include "heap.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "defines.h"
+
+HeapElement newHeapElem(unsigned dist, int minYear, int id) {
+  HeapElement elem;
+  elem.dist = dist;
+  elem.minYear = minYear;
+  elem.id = id;
+  return elem;
+}
+
+Heap *newHeap() {
+  Heap *heap = (Heap *)malloc(sizeof(Heap));
+  if (heap == NULL) {
+    return NULL;
+  }
+
+  heap->elems =
+      (HeapElement *)malloc(INITIAL_HEAP_CAPACITY * sizeof(HeapElement));
+  if (heap->elems == NULL) {
+    free(heap);
+    return NULL;
+  }
+
+  heap->size = 0;
+  heap->capacity = INITIAL_HEAP_CAPACITY;
+  return heap;
+}
+
+void deleteHeap(Heap *heap) {
+  if (heap == NULL) {
+    return;
+  }
+  free(heap->elems);
+  free(heap);
+}
+
+void clearHeap(Heap *heap) {
+  assert(heap);
+  heap->size = 0;
+}
+
+bool isEmptyHeap(Heap *heap) {
+  assert(heap);
+  return heap->size == 0;
+}
+
+static bool isLess(HeapElement a, HeapElement b) {
+  if (a.dist != b.dist) {
+    return a.dist < b.dist;
+  }
+  if (a.minYear != b.minYear) {
+    return a.minYear > b.minYear;
+  }
+  return a.id < b.id;
+}
+
+bool pushHeap(Heap *heap, HeapElement elem) {
+  assert(heap);
+
+  if (heap->size == heap->capacity) {
+    HeapElement *elems = (HeapElement *)realloc(
+        heap->elems, 2 * heap->capacity * sizeof(HeapElement));
+    if (elems == NULL) {
+      return false;
+    }
+    heap->elems = elems;
+    heap->capacity *= 2;
+  }
+
+  int pos = heap->size++;
+  while (pos > 0 && isLess(elem, heap->elems[(pos - 1) / 2])) {
+    heap->elems[pos] = heap->elems[(pos - 1) / 2];
+    pos = (pos - 1) / 2;
+  }
+  heap->elems[pos] = elem;
+  return true;
+}
+
+HeapElement topHeap(Heap *heap) {
+  assert(heap);
+  assert(heap->size > 0);
+  return heap->elems[0];
+}
+
+HeapElement popHeap(Heap *heap) {
+  assert(heap);
+  assert(heap->size > 0);
+
+  HeapElement top = heap->elems[0];
+  HeapElement last = heap->elems[--heap->size];
+
+  int pos = 0;
+  while (2 * pos + 1 < heap->size) {
+    int child = 2 * pos + 1;
+    if (child + 1 < heap->size &&
+        isLess(heap->elems[child + 1], heap->elems[child])) {
+      child++;
+    }
+    if (!isLess(heap->elems[child], last)) {
+      break;
+    }
+    heap->elems[pos] = heap->elems[child];
+    pos = child;
+  }
+  heap->elems[pos] = last;
+  return top;
+}
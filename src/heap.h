@@ -0,0 +1,85 @@
+/** @file
+ * Interfejs kopca binarnego, wykorzystywanego przez algorytm Dijkstry
+ */
+
+#ifndef __HEAP_H__
+#define __HEAP_H__
+
+#include <stdbool.h>
+
+/**
+ * Element kopca.
+ */
+typedef struct HeapElement {
+  unsigned dist;  ///< odległość miasta od miasta startowego
+  int minYear;    ///< najstarszy rok budowy lub remontu na drodze do miasta
+  int id;         ///< numer miasta
+} HeapElement;
+
+/**
+ * Kopiec binarny, uporządkowany rosnąco według odległości, w przypadku
+ * równych odległości malejąco według roku @p minYear, a w przypadku równych
+ * lat rosnąco według numeru miasta.
+ */
+typedef struct Heap {
+  HeapElement *elems;  ///< tablica elementów kopca
+  int size;            ///< liczba elementów w kopcu
+  int capacity;        ///< rozmiar zaalokowanej tablicy
+} Heap;
+
+/** @brief Tworzy nowy element kopca.
+ * @param[in] dist    – odległość miasta od miasta startowego;
+ * @param[in] minYear – najstarszy rok budowy lub remontu na drodze do miasta;
+ * @param[in] id      – numer miasta.
+ * @return Element kopca.
+ */
+HeapElement newHeapElem(unsigned dist, int minYear, int id);
+
+/** @brief Tworzy nowy, pusty kopiec.
+ * @return Wskaźnik na kopiec lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+Heap *newHeap();
+
+/** @brief Usuwa kopiec.
+ * Nic nie robi, jeśli @p heap ma wartość NULL.
+ * @param[in] heap – wskaźnik na kopiec.
+ */
+void deleteHeap(Heap *heap);
+
+/** @brief Usuwa wszystkie elementy kopca.
+ * Nie zwalnia zaalokowanej pamięci, dzięki czemu kopiec można wykorzystać
+ * ponownie.
+ * @param[in,out] heap – wskaźnik na kopiec.
+ */
+void clearHeap(Heap *heap);
+
+/** @brief Sprawdza, czy kopiec jest pusty.
+ * @param[in] heap – wskaźnik na kopiec.
+ * @return Wartość @p true, jeśli kopiec jest pusty.
+ * Wartość @p false wpp.
+ */
+bool isEmptyHeap(Heap *heap);
+
+/** @brief Dodaje element do kopca.
+ * @param[in,out] heap – wskaźnik na kopiec;
+ * @param[in] elem     – dodawany element.
+ * @return Wartość @p true, jeśli udało się dodać element.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+bool pushHeap(Heap *heap, HeapElement elem);
+
+/** @brief Zwraca najmniejszy element kopca, nie usuwając go.
+ * Kopiec nie może być pusty.
+ * @param[in] heap – wskaźnik na kopiec.
+ * @return Najmniejszy element kopca.
+ */
+HeapElement topHeap(Heap *heap);
+
+/** @brief Usuwa i zwraca najmniejszy element kopca.
+ * Kopiec nie może być pusty.
+ * @param[in,out] heap – wskaźnik na kopiec.
+ * @return Najmniejszy element kopca.
+ */
+HeapElement popHeap(Heap *heap);
+
+#endif  // __HEAP_H__
@@ -0,0 +1,150 @@
+#include "line_fields.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "byte_scan.h"
+#include "defines.h"
+
+LineFields *newLineFields() {
+  LineFields *fields = (LineFields *)malloc(sizeof(LineFields));
+  if (fields == NULL) {
+    return NULL;
+  }
+
+  fields->semicolons = NULL;
+  fields->controls = NULL;
+  fields->fields =
+      (LineField *)malloc(INITIAL_FIELDS_CAPACITY * sizeof(LineField));
+  if (fields->fields == NULL) {
+    free(fields);
+    return NULL;
+  }
+
+  fields->semicolons =
+      (uint32_t *)malloc(INITIAL_SCAN_BLOCKS * sizeof(uint32_t));
+  fields->controls = (uint32_t *)malloc(INITIAL_SCAN_BLOCKS * sizeof(uint32_t));
+  if (fields->semicolons == NULL || fields->controls == NULL) {
+    deleteLineFields(fields);
+    return NULL;
+  }
+
+  fields->count = 0;
+  fields->capacity = INITIAL_FIELDS_CAPACITY;
+  fields->hasEmptyField = false;
+  fields->blocksCapacity = INITIAL_SCAN_BLOCKS;
+  return fields;
+}
+
+void deleteLineFields(LineFields *fields) {
+  if (fields == NULL) {
+    return;
+  }
+  free(fields->fields);
+  free(fields->semicolons);
+  free(fields->controls);
+  free(fields);
+}
+
+// Dopisuje pole zaczynające się w miejscu @p chars.
+static bool addField(LineFields *fields, char *chars, size_t length,
+                     bool hasControlChars) {
+  if (fields->count == fields->capacity) {
+    LineField *array = (LineField *)realloc(
+        fields->fields, 2 * fields->capacity * sizeof(LineField));
+    if (array == NULL) {
+      return false;
+    }
+    fields->fields = array;
+    fields->capacity *= 2;
+  }
+
+  fields->fields[fields->count].chars = chars;
+  fields->fields[fields->count].length = length;
+  fields->fields[fields->count].hasControlChars = hasControlChars;
+  fields->count++;
+  return true;
+}
+
+// Powiększa tablice masek tak, aby mieściły @p blocks bloków.
+static bool reserveBlocks(LineFields *fields, size_t blocks) {
+  if (blocks <= fields->blocksCapacity) {
+    return true;
+  }
+
+  size_t capacity = fields->blocksCapacity;
+  while (capacity < blocks) {
+    capacity *= 2;
+  }
+
+  uint32_t *semicolons =
+      (uint32_t *)realloc(fields->semicolons, capacity * sizeof(uint32_t));
+  if (semicolons == NULL) {
+    return false;
+  }
+  fields->semicolons = semicolons;
+
+  uint32_t *controls =
+      (uint32_t *)realloc(fields->controls, capacity * sizeof(uint32_t));
+  if (controls == NULL) {
+    return false;
+  }
+  fields->controls = controls;
+
+  fields->blocksCapacity = capacity;
+  return true;
+}
+
+bool splitLine(LineFields *fields, char *line, size_t length) {
+  assert(fields);
+
+  fields->count = 0;
+  fields->hasEmptyField = false;
+
+  size_t blocks = (length + SCAN_BLOCK_SIZE - 1) / SCAN_BLOCK_SIZE;
+  if (!reserveBlocks(fields, blocks)) {
+    return false;
+  }
+  scanLineMasks(line, length, fields->semicolons, fields->controls);
+
+  char *begin = line;
+  bool hasControlChars = false;
+  for (size_t block = 0; block < blocks; block++) {
+    uint32_t semicolons = fields->semicolons[block];
+    uint32_t controls = fields->controls[block];
+
+    while (semicolons != 0) {
+      int bit = lowestSetBit(semicolons);
+      // bity znaków należących do bieżącego pola, łącznie ze średnikiem
+      uint32_t field = semicolons ^ (semicolons - 1);
+
+      char *separator = line + block * SCAN_BLOCK_SIZE + (size_t)bit;
+      if (separator == begin) {
+        fields->hasEmptyField = true;
+        return true;
+      }
+
+      *separator = '\0';
+      hasControlChars |= (controls & field) != 0;
+      if (!addField(fields, begin, (size_t)(separator - begin),
+                    hasControlChars)) {
+        return false;
+      }
+
+      begin = separator + 1;
+      hasControlChars = false;
+      controls &= ~field;
+      semicolons &= ~field;
+    }
+    hasControlChars |= controls != 0;
+  }
+
+  char *end = line + length;
+  if (begin == end) {
+    fields->hasEmptyField = true;
+    return true;
+  }
+  return addField(fields, begin, (size_t)(end - begin), hasControlChars);
+}
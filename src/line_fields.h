@@ -0,0 +1,63 @@
+/** @file
+ * Interfejs podziału wiersza polecenia na pola rozdzielone średnikami
+ */
+
+#ifndef __LINE_FIELDS_H__
+#define __LINE_FIELDS_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Pole wiersza, zakończone znakiem '\0' wpisanym w miejsce średnika.
+ */
+typedef struct LineField {
+  char *chars;           ///< wskaźnik na początek pola w wierszu
+  size_t length;         ///< długość pola
+  bool hasControlChars;  ///< informacja, czy pole zawiera znak o kodzie < 32
+} LineField;
+
+/**
+ * Pola ostatnio podzielonego wiersza. Tablice pól i masek są wykorzystywane
+ * przez kolejne wiersze i powiększane tylko wtedy, gdy wiersz ma więcej pól
+ * lub jest dłuższy niż którykolwiek wcześniejszy.
+ */
+typedef struct LineFields {
+  LineField *fields;      ///< tablica pól
+  size_t count;           ///< liczba pól wiersza
+  size_t capacity;        ///< rozmiar tablicy @p fields
+  bool hasEmptyField;     ///< informacja, czy któreś z pól jest puste
+  uint32_t *semicolons;   ///< maski średników kolejnych bloków wiersza
+  uint32_t *controls;     ///< maski znaków sterujących bloków wiersza
+  size_t blocksCapacity;  ///< rozmiar tablic masek
+} LineFields;
+
+/** @brief Tworzy nową strukturę.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci.
+ */
+LineFields *newLineFields();
+
+/** @brief Usuwa strukturę.
+ * Nic nie robi, jeśli wskaźnik @p fields ma wartość NULL.
+ * @param[in] fields – wskaźnik na usuwaną strukturę.
+ */
+void deleteLineFields(LineFields *fields);
+
+/** @brief Dzieli wiersz na pola.
+ * Wyznacza maski średników i znaków sterujących funkcją @ref scanLineMasks,
+ * a następnie zastępuje średniki znakami '\0' i dla każdego pola zapamiętuje,
+ * czy zawiera ono znak sterujący, co pozwala sprawdzić poprawność nazwy
+ * miasta bez ponownego przeglądania pola. Wiersz musi być zakończony znakiem
+ * '\0'. Po znalezieniu pustego pola przerywa podział i ustawia
+ * @p hasEmptyField, bo taki wiersz jest niepoprawny.
+ * @param[in,out] fields – wskaźnik na strukturę;
+ * @param[in,out] line   – wskaźnik na wiersz;
+ * @param[in] length     – długość wiersza.
+ * @return Wartość @p true, jeśli udało się podzielić wiersz.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+bool splitLine(LineFields *fields, char *line, size_t length);
+
+#endif  // __LINE_FIELDS_H__
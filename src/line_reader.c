@@ -0,0 +1,121 @@
+// open, read i close są częścią POSIX, a nie standardu C11
+#define _POSIX_C_SOURCE 200809L
+
+#include "line_reader.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "defines.h"
+
+LineReader *newLineReader(int fd) {
+  LineReader *reader = (LineReader *)malloc(sizeof(LineReader));
+  if (reader == NULL) {
+    return NULL;
+  }
+
+  reader->buffer = (char *)malloc(READ_BLOCK_SIZE * sizeof(char));
+  if (reader->buffer == NULL) {
+    free(reader);
+    return NULL;
+  }
+
+  reader->fd = fd;
+  reader->capacity = READ_BLOCK_SIZE;
+  reader->begin = 0;
+  reader->scanned = 0;
+  reader->end = 0;
+  return reader;
+}
+
+LineReader *openLineReader(const char *path) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  LineReader *reader = newLineReader(fd);
+  if (reader == NULL) {
+    close(fd);
+  }
+  return reader;
+}
+
+void deleteLineReader(LineReader *reader) {
+  if (reader == NULL) {
+    return;
+  }
+  if (reader->fd > STDERR_FILENO) {
+    close(reader->fd);
+  }
+  free(reader->buffer);
+  free(reader);
+}
+
+// Przenosi niedokończony wiersz na początek bufora i dopisuje za nim
+// kolejny blok danych. Zwraca @p false, jeśli nie ma już danych.
+static bool fillBuffer(LineReader *reader) {
+  if (reader->begin > 0) {
+    memmove(reader->buffer, reader->buffer + reader->begin,
+            reader->end - reader->begin);
+    reader->scanned -= reader->begin;
+    reader->end -= reader->begin;
+    reader->begin = 0;
+  }
+
+  if (reader->end == reader->capacity) {
+    char *buffer = (char *)realloc(reader->buffer,
+                                   2 * reader->capacity * sizeof(char));
+    if (buffer == NULL) {
+      return false;
+    }
+    reader->buffer = buffer;
+    reader->capacity *= 2;
+  }
+
+  ssize_t count;
+  do {
+    count = read(reader->fd, reader->buffer + reader->end,
+                 reader->capacity - reader->end);
+  } while (count < 0 && errno == EINTR);
+  if (count <= 0) {
+    return false;
+  }
+
+  reader->end += (size_t)count;
+  return true;
+}
+
+bool nextLine(LineReader *reader, char **line, size_t *length) {
+  assert(reader);
+
+  char *newline;
+  while ((newline = memchr(reader->buffer + reader->scanned, '\n',
+                           reader->end - reader->scanned)) == NULL) {
+    reader->scanned = reader->end;
+    if (!fillBuffer(reader)) {
+      return false;
+    }
+  }
+
+  *line = reader->buffer + reader->begin;
+  *length = (size_t)(newline - *line);
+  *newline = '\0';
+
+  // znak '\0' zmieniam na inny niepoprawny znak po to, aby nie
+  // sygnalizował on końca wiersza
+  char *zero = memchr(*line, '\0', *length);
+  while (zero != NULL) {
+    *zero = (char)1;
+    zero = memchr(zero + 1, '\0', (size_t)(newline - zero - 1));
+  }
+
+  reader->begin = (size_t)(newline - reader->buffer) + 1;
+  reader->scanned = reader->begin;
+  return true;
+}
@@ -0,0 +1,62 @@
+/** @file
+ * Interfejs czytnika wierszy wejścia, wczytującego dane dużymi blokami
+ */
+
+#ifndef __LINE_READER_H__
+#define __LINE_READER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Czytnik wierszy. Dane są wczytywane z deskryptora dużymi blokami, a kolejne
+ * wiersze są zwracane jako fragmenty bufora, bez kopiowania.
+ */
+typedef struct LineReader {
+  int fd;           ///< deskryptor, z którego wczytywane są bloki
+  char *buffer;     ///< bufor z wczytanymi danymi
+  size_t capacity;  ///< rozmiar bufora
+  size_t begin;     ///< początek pierwszego nieprzetworzonego wiersza
+  size_t scanned;   ///< koniec fragmentu przeszukanego w poszukiwaniu '\n'
+  size_t end;       ///< koniec wczytanych danych
+} LineReader;
+
+/** @brief Tworzy czytnik wczytujący dane z deskryptora @p fd.
+ * Bloki są wczytywane funkcją read, więc wiersze podawane interaktywnie są
+ * przetwarzane od razu po ich wprowadzeniu.
+ * @param[in] fd – deskryptor otwarty do czytania.
+ * @return Wskaźnik na czytnik lub NULL, gdy nie udało się zaalokować
+ * pamięci.
+ */
+LineReader *newLineReader(int fd);
+
+/** @brief Tworzy czytnik wierszy pliku @p path.
+ * Otwiera plik i wczytuje go blokami tak jak @ref newLineReader.
+ * @param[in] path – ścieżka do pliku.
+ * @return Wskaźnik na czytnik lub NULL, gdy nie udało się otworzyć pliku lub
+ * zaalokować pamięci.
+ */
+LineReader *openLineReader(const char *path);
+
+/** @brief Usuwa czytnik.
+ * Zamyka otwarty przez niego plik. Nic nie robi, jeśli wskaźnik @p reader
+ * ma wartość NULL.
+ * @param[in] reader – wskaźnik na usuwany czytnik.
+ */
+void deleteLineReader(LineReader *reader);
+
+/** @brief Zwraca kolejny wiersz wejścia.
+ * Znak '\n' kończący wiersz jest zastępowany znakiem '\0', a znaki '\0'
+ * wewnątrz wiersza znakiem o kodzie 1, który nie może wystąpić w poprawnym
+ * poleceniu. Wiersz pozostaje ważny do kolejnego wywołania. Ostatni wiersz,
+ * niezakończony znakiem '\n', nie jest zwracany.
+ * @param[in,out] reader – wskaźnik na czytnik;
+ * @param[out] line      – wskaźnik na początek wiersza;
+ * @param[out] length    – długość wiersza.
+ * @return Wartość @p true, jeśli udało się wczytać wiersz.
+ * Wartość @p false, jeśli skończyło się wejście, wystąpił błąd odczytu lub
+ * nie udało się zaalokować pamięci.
+ */
+bool nextLine(LineReader *reader, char **line, size_t *length);
+
+#endif  // __LINE_READER_H__
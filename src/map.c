@@ -8,7 +8,10 @@
 
 #include "cities_list.h"
 #include "defines.h"
+#include "heap.h"
 #include "national_route.h"
+#include "roads_graph.h"
+#include "search_workspace.h"
 #include "strings.h"
 #include "trie.h"
 
@@ -18,8 +21,16 @@ Map *newMap() {
     return NULL;
   }
 
-  map->trie = newTrieNode();
+  map->pools = newNodePools();
+  if (map->pools == NULL) {
+    free(map);
+    map = NULL;
+    return NULL;
+  }
+
+  map->trie = newTrieNode(map->pools);
   if (map->trie == NULL) {
+    deleteNodePools(map->pools);
     free(map);
     map = NULL;
     return NULL;
@@ -28,7 +39,34 @@ Map *newMap() {
   map->nationalRoutes =
       (NationalRoute **)malloc(1000 * sizeof(NationalRoute *));
   if (map->nationalRoutes == NULL) {
-    deleteTrie(map->trie);
+    deleteNodePools(map->pools);
+    free(map);
+    map = NULL;
+    return NULL;
+  }
+
+  map->workspace = newSearchWorkspace();
+  if (map->workspace == NULL) {
+    deleteNodePools(map->pools);
+    free(map->nationalRoutes);
+    free(map);
+    map = NULL;
+    return NULL;
+  }
+
+  map->backWorkspace = newSearchWorkspace();
+  map->graph = newRoadsGraph();
+  map->cities = (Trie **)malloc(INITIAL_CITIES_CAPACITY * sizeof(Trie *));
+  map->names = newCityNames();
+  if (map->backWorkspace == NULL || map->graph == NULL ||
+      map->cities == NULL || map->names == NULL) {
+    deleteNodePools(map->pools);
+    free(map->nationalRoutes);
+    deleteSearchWorkspace(map->workspace);
+    deleteSearchWorkspace(map->backWorkspace);
+    deleteRoadsGraph(map->graph);
+    free(map->cities);
+    deleteCityNames(map->names);
     free(map);
     map = NULL;
     return NULL;
@@ -36,6 +74,7 @@ Map *newMap() {
 
   memset(map->nationalRoutes, 0, 1000 * sizeof(NationalRoute *));
   map->numOfCities = 0;
+  map->citiesCapacity = INITIAL_CITIES_CAPACITY;
   return map;
 }
 
@@ -43,20 +82,97 @@ void deleteMap(Map *map) {
   if (map == NULL) {
     return;
   }
-  deleteTrie(map->trie);
+  // węzły drzewa, list i odcinki dróg są zwalniane razem z pulami
+  for (int i = 0; i < map->numOfCities; i++) {
+    if (map->cities[i] != NULL) {
+      deleteRoadsIndex(map->cities[i]->index);
+    }
+  }
   deleteNationalRoutes(map->nationalRoutes);
+  deleteSearchWorkspace(map->workspace);
+  deleteSearchWorkspace(map->backWorkspace);
+  deleteRoadsGraph(map->graph);
+  deleteNodePools(map->pools);
+  deleteCityNames(map->names);
+  free(map->cities);
   free(map);
   map = NULL;
 }
 
 bool addCity(Map *map, const char *city) {
-  return insertStr(map->trie, city, map->numOfCities++);
+  if (map->numOfCities == map->citiesCapacity) {
+    Trie **cities = (Trie **)realloc(
+        map->cities, 2 * map->citiesCapacity * sizeof(Trie *));
+    if (cities == NULL) {
+      return false;
+    }
+    map->cities = cities;
+    map->citiesCapacity *= 2;
+  }
+  if (!reserveGraphCities(map->graph, map->numOfCities + 1)) {
+    return false;
+  }
+
+  if (!addCityName(map->names, city)) {
+    return false;
+  }
+
+  int id = map->numOfCities++;
+  map->cities[id] = insertStr(map->pools, map->trie, city, id);
+  return map->cities[id] != NULL;
 }
 
 Trie *getCityPtr(Map *map, const char *city) {
   return getNodePtr(map->trie, city);
 }
 
+static CityId findCity(Map *map, const char *city) {
+  Trie *cityPtr = getCityPtr(map, city);
+  return cityPtr == NULL ? NO_CITY : cityPtr->id;
+}
+
+static CityId findOrAddCity(Map *map, const char *city) {
+  CityId id = findCity(map, city);
+  if (id != NO_CITY) {
+    return id;
+  }
+  if (!addCity(map, city)) {
+    return NO_CITY;
+  }
+  return map->numOfCities - 1;
+}
+
+CityId lookupCity(Map *map, const char *city) {
+  if (map == NULL || !isValidCityName(city)) {
+    return NO_CITY;
+  }
+  return findCity(map, city);
+}
+
+CityId internCity(Map *map, const char *city) {
+  if (map == NULL || !isValidCityName(city)) {
+    return NO_CITY;
+  }
+  return findOrAddCity(map, city);
+}
+
+CityId lookupCityUnchecked(Map *map, const char *city) {
+  assert(map);
+  return findCity(map, city);
+}
+
+CityId internCityUnchecked(Map *map, const char *city) {
+  assert(map);
+  return findOrAddCity(map, city);
+}
+
+Trie *getCityById(Map *map, CityId city) {
+  if (map == NULL || city < 0 || city >= map->numOfCities) {
+    return NULL;
+  }
+  return map->cities[city];
+}
+
 bool addRoad(Map *map, const char *city1, const char *city2, unsigned length,
              int builtYear) {
   if (map == NULL) {
@@ -72,31 +188,48 @@ bool addRoad(Map *map, const char *city1, const char *city2, unsigned length,
     return false;
   }
 
-  Trie *city1Ptr = getCityPtr(map, city1);
-  Trie *city2Ptr = getCityPtr(map, city2);
-  if (city1Ptr != NULL && city2Ptr != NULL) {
-    if (isNeighbour(city1Ptr, city2Ptr)) {
-      return false;
-    }
+  CityId city1Id = findOrAddCity(map, city1);
+  if (city1Id == NO_CITY) {
+    return false;
   }
-
-  bool res1 = true, res2 = true;
-  if (city1Ptr == NULL) {
-    res1 = addCity(map, city1);
+  CityId city2Id = findOrAddCity(map, city2);
+  if (city2Id == NO_CITY) {
+    return false;
   }
-  if (city2Ptr == NULL) {
-    res2 = addCity(map, city2);
+
+  return addRoadById(map, city1Id, city2Id, length, builtYear);
+}
+
+// Zwraca wskaźnik na miejsce, w którym zapisany jest indeks w grafie
+// odcinka @p road wychodzącego z miasta @p from do miasta @p to.
+static int *getRoadEdge(Road *road, CityId from, CityId to) {
+  return &road->edges[from < to ? 0 : 1];
+}
+
+bool addRoadById(Map *map, CityId city1, CityId city2, unsigned length,
+                 int builtYear) {
+  if (builtYear == 0 || length == 0 || city1 == city2) {
+    return false;
   }
 
-  if (!(res1 && res2)) {
+  Trie *city1Ptr = getCityById(map, city1);
+  Trie *city2Ptr = getCityById(map, city2);
+  if (city1Ptr == NULL || city2Ptr == NULL) {
+    return false;
+  }
+  if (isNeighbour(city1Ptr, city2Ptr)) {
     return false;
   }
 
-  city1Ptr = getCityPtr(map, city1);
-  city2Ptr = getCityPtr(map, city2);
+  if (!addRoadSection(city1Ptr, city2Ptr, length, builtYear)) {
+    return false;
+  }
 
-  res1 = addRoadSection(city1Ptr, city2Ptr, length, builtYear);
-  res2 = addRoadSection(city2Ptr, city1Ptr, length, builtYear);
+  Road *road = getRoadBetweenCities(city1Ptr, city2Ptr);
+  bool res1 = addGraphEdge(map->graph, city1, city2, length, builtYear,
+                           getRoadEdge(road, city1, city2));
+  bool res2 = addGraphEdge(map->graph, city2, city1, length, builtYear,
+                           getRoadEdge(road, city2, city1));
 
   return res1 && res2;
 }
@@ -106,18 +239,21 @@ bool repairRoad(Map *map, const char *city1, const char *city2,
   if (map == NULL) {
     return false;
   }
-  if (repairYear == 0) {
-    return false;
-  }
-  if (strcmp(city1, city2) == 0) {
+  if (!isValidCityName(city1) || !isValidCityName(city2)) {
     return false;
   }
-  if (!isValidCityName(city1) || !isValidCityName(city2)) {
+
+  return repairRoadById(map, findCity(map, city1), findCity(map, city2),
+                        repairYear);
+}
+
+bool repairRoadById(Map *map, CityId city1, CityId city2, int repairYear) {
+  if (repairYear == 0 || city1 == city2) {
     return false;
   }
 
-  Trie *city1Ptr = getCityPtr(map, city1);
-  Trie *city2Ptr = getCityPtr(map, city2);
+  Trie *city1Ptr = getCityById(map, city1);
+  Trie *city2Ptr = getCityById(map, city2);
   if (city1Ptr == NULL || city2Ptr == NULL) {
     return false;
   }
@@ -130,164 +266,147 @@ bool repairRoad(Map *map, const char *city1, const char *city2,
     return false;
   }
 
-  repairRoadSection(city1Ptr, city2Ptr, repairYear);
-  repairRoadSection(city2Ptr, city1Ptr, repairYear);
+  setRoadRepairYear(map, city1Ptr, city2Ptr, repairYear);
   return true;
 }
 
-void concatenateCityNameToResult(char **str, size_t *strLength,
-                                 unsigned int *pos, Trie *city) {
-  if (city->parent != NULL) {
-    concatenateCityNameToResult(str, strLength, pos, city->parent);
-  }
-  if (city->character != '\0') {
-    while (*pos + 1 >= *strLength) {
-      *strLength *= 2;
-      *str = realloc(*str, *strLength * sizeof(char));
-      if (*str == NULL) {
-        return;
-      }
-    }
-    (*str)[(*pos)++] = city->character;
-  }
-}
-
-void concatenateIntToResult(char **str, size_t *strLength, unsigned int *pos,
-                            int val) {
-  char *buffer = malloc(20 * sizeof(char));
-  if (buffer == NULL) {
-    return;
-  }
+void setRoadRepairYear(Map *map, Trie *city1, Trie *city2, int repairYear) {
+  Road *road = getRoadBetweenCities(city1, city2);
+  assert(road);
 
-  int n = sprintf(buffer, "%d;", val);
-  while (*pos + n >= *strLength) {
-    *strLength *= 2;
-    *str = realloc(*str, *strLength * sizeof(char));
-    if (*str == NULL) {
-      free(buffer);
-      return;
-    }
+  RoutesListNode *route = road->routes->head->next;
+  while (isValidRoutesListNode(route)) {
+    invalidateRouteDescription(map->nationalRoutes[route->elem.routeId]);
+    route = route->next;
   }
 
-  for (int i = 0; i < n; i++) {
-    (*str)[(*pos)++] = buffer[i];
-  }
-  free(buffer);
-  buffer = NULL;
+  repairRoadSection(city1, city2, repairYear);
+  repairGraphEdge(map->graph, *getRoadEdge(road, city1->id, city2->id),
+                  repairYear);
+  repairGraphEdge(map->graph, *getRoadEdge(road, city2->id, city1->id),
+                  repairYear);
 }
 
-void concatenateUnsignedToResult(char **str, size_t *strLength,
-                                 unsigned int *pos, unsigned val) {
-  char *buffer = malloc(20 * sizeof(char));
-  if (buffer == NULL) {
-    return;
-  }
-
-  int n = sprintf(buffer, "%u;", val);
-  while (*pos + n >= *strLength) {
-    *strLength *= 2;
-    *str = realloc(*str, *strLength * sizeof(char));
-    if (*str == NULL) {
-      free(buffer);
-      buffer = NULL;
-      return;
+static bool streamRouteDescription(Map *map, NationalRoute *nationalRoute,
+                                   RouteSink *sink) {
+  RouteWriter writer;
+  initRouteWriter(&writer, sink);
+  writeInt(&writer, nationalRoute->id);
+  writeChar(&writer, ';');
+
+  int length = getRouteLength(nationalRoute);
+  for (int i = 0; i < length; i++) {
+    RouteSection *section = getRouteSection(nationalRoute, i);
+    Trie *city = section->city;
+
+    writeChars(&writer, getCityName(map->names, city->id),
+               getCityNameLength(map->names, city->id));
+    if (section->road != NULL) {
+      writeChar(&writer, ';');
+      writeUnsigned(&writer, section->road->length);
+      writeChar(&writer, ';');
+      writeInt(&writer, section->road->builtYear);
+      writeChar(&writer, ';');
     }
   }
 
-  for (int i = 0; i < n; i++) {
-    (*str)[(*pos)++] = buffer[i];
-  }
-  free(buffer);
-  buffer = NULL;
+  return flushRouteWriter(&writer);
 }
 
-const char *getRouteDescription(Map *map, unsigned routeId) {
-  char *result = NULL;
-
-  size_t resultLength = INITIAL_LINE_LENGTH;
-  result = (char *)malloc(resultLength * sizeof(char));
-
-  memset(result, 0, resultLength * sizeof(char));
-  if (result == NULL) {
-    return result;
+/**
+ * Napis o rosnącym rozmiarze, do którego trafia opis drogi krajowej.
+ */
+typedef struct DescriptionString {
+  char *chars;      ///< tablica znaków napisu
+  size_t length;    ///< długość napisu
+  size_t capacity;  ///< rozmiar tablicy @p chars
+} DescriptionString;
+
+static bool appendToDescription(void *data, const char *chunk, size_t length) {
+  DescriptionString *str = (DescriptionString *)data;
+  if (str->length + length + 1 > str->capacity) {
+    size_t capacity = str->capacity;
+    while (str->length + length + 1 > capacity) {
+      capacity *= 2;
+    }
+    char *chars = (char *)realloc(str->chars, capacity * sizeof(char));
+    if (chars == NULL) {
+      return false;
+    }
+    str->chars = chars;
+    str->capacity = capacity;
   }
+  memcpy(str->chars + str->length, chunk, length);
+  str->length += length;
+  return true;
+}
 
-  memset(result, 0, resultLength * sizeof(char));
-  assert(result);
-
-  if (map == NULL) {
-    return result;
-  }
-  if (routeId > 999 || routeId == 0) {
-    return result;
+const char *getCachedRouteDescription(Map *map, unsigned routeId,
+                                      size_t *length) {
+  *length = 0;
+  if (map == NULL || routeId == 0 || routeId > 999) {
+    return "";
   }
 
   NationalRoute *nationalRoute = map->nationalRoutes[routeId];
   if (nationalRoute == NULL) {
-    return result;
-  }
-
-  unsigned int pos = 0;
-  concatenateIntToResult(&result, &resultLength, &pos, nationalRoute->id);
-  if (result == NULL) {
-    return result;
+    return "";
   }
 
-  assert(nationalRoute->list);
-  assert(nationalRoute->list->head);
-  assert(nationalRoute->list->head->next);
-
-  CitiesListNode *iter = nationalRoute->list->head->next;
-  while (isValidCitiesListNode(iter) && isValidCitiesListNode(iter->next)) {
-    concatenateCityNameToResult(&result, &resultLength, &pos, iter->elem.city);
-
-    if (result == NULL) {
-      return result;
+  if (nationalRoute->description == NULL) {
+    DescriptionString str;
+    str.length = 0;
+    str.capacity = INITIAL_LINE_LENGTH;
+    str.chars = (char *)malloc(str.capacity * sizeof(char));
+    if (str.chars == NULL) {
+      return NULL;
     }
-    if (pos + 1 >= resultLength) {
-      resultLength *= 2;
-      result = realloc(result, resultLength * sizeof(char));
-    }
-    if (result == NULL) {
-      return result;
+
+    RouteSink sink = callbackRouteSink(appendToDescription, &str);
+    if (!streamRouteDescription(map, nationalRoute, &sink)) {
+      free(str.chars);
+      return NULL;
     }
-    result[pos++] = ';';
 
-    concatenateUnsignedToResult(
-        &result, &resultLength, &pos,
-        getRoadLength(iter->elem.city, iter->next->elem.city));
+    str.chars[str.length] = '\0';
+    nationalRoute->description = str.chars;
+    nationalRoute->descriptionLength = str.length;
+  }
 
-    if (result == NULL) {
-      return result;
-    }
+  *length = nationalRoute->descriptionLength;
+  return nationalRoute->description;
+}
 
-    concatenateIntToResult(
-        &result, &resultLength, &pos,
-        getRepairYear(iter->elem.city, iter->next->elem.city));
+bool writeRouteDescription(Map *map, unsigned routeId, RouteSink *sink) {
+  size_t length;
+  const char *description = getCachedRouteDescription(map, routeId, &length);
+  if (description == NULL) {
+    // brak pamięci na opis, więc zapisujemy go bezpośrednio
+    return streamRouteDescription(map, map->nationalRoutes[routeId], sink);
+  }
+  if (length == 0) {
+    return true;
+  }
+  return sink->write(sink->data, description, length);
+}
 
-    if (result == NULL) {
-      return result;
-    }
-    iter = iter->next;
+const char *getRouteDescription(Map *map, unsigned routeId) {
+  size_t length;
+  const char *description = getCachedRouteDescription(map, routeId, &length);
+  if (description == NULL) {
+    return NULL;
   }
-  concatenateCityNameToResult(&result, &resultLength, &pos, iter->elem.city);
 
+  char *result = (char *)malloc((length + 1) * sizeof(char));
   if (result == NULL) {
-    return result;
+    return NULL;
   }
-  result[pos] = '\0';
+  memcpy(result, description, length + 1);
   return result;
 }
 
 bool isCityInRoute(Trie *city, NationalRoute *route) {
-  CitiesListNode *iter = route->list->head->next;
-  while (isValidCitiesListNode(iter)) {
-    if (city == iter->elem.city) {
-      return true;
-    }
-    iter = iter->next;
-  }
-  return false;
+  return isCityIdInRoute(route, city->id);
 }
 
 SpfaResult *makeNewSpfaResult() {
@@ -297,7 +416,7 @@ SpfaResult *makeNewSpfaResult() {
   }
   spfaResult->dist = 0;
   spfaResult->isCorrect = false;
-  spfaResult->prev = NULL;
+  spfaResult->path = NULL;
   spfaResult->minYear = INF;
   return spfaResult;
 }
@@ -306,156 +425,445 @@ void deleteResult(SpfaResult *result) {
   if (result == NULL) {
     return;
   }
-  free(result->prev);
+  deleteCitiesList(result->path);
   free(result);
 }
 
-CitiesList *prevToCitiesList(Trie **prev, Trie *cityPtr) {
-  CitiesList *list = makeNewCitiesList();
+CitiesList *prevToCitiesList(Map *m, Trie *cityPtr) {
+  CitiesList *list = makeNewCitiesList(m->pools);
   if (list == NULL) {
     return NULL;
   }
 
-  while (cityPtr != NULL) {
-    addCitiesListNode(list, cityPtr);
-    cityPtr = prev[cityPtr->id];
+  int id = cityPtr->id;
+  while (id != -1) {
+    if (!addCitiesListNode(list, m->cities[id])) {
+      deleteCitiesList(list);
+      return NULL;
+    }
+    id = getSearchLabel(m->workspace, id)->prev;
   }
   reverseCitiesList(list);
   return list;
 }
 
+// Rozluźnia odcinki wychodzące z miasta @p currId. Pomija miasta drogi
+// krajowej @p route, poza miastem @p finalId, do którego nie można wejść
+// bezpośrednio z miasta @p startId, oraz miastem @p openId.
+static bool relaxRoads(Map *m, NationalRoute *route, int currId, int startId,
+                       int finalId, int openId) {
+  SearchWorkspace *workspace = m->workspace;
+  RoadsGraph *graph = m->graph;
+  SearchLabel *curr = getSearchLabel(workspace, currId);
+
+  GraphRow *row = &graph->rows[currId];
+  GraphEdge *iter = graph->edges + row->begin;
+  GraphEdge *end = iter + row->degree;
+  for (; iter != end; iter++) {
+    int neighbourId = iter->neighbour;
+    SearchLabel *next = getSearchLabel(workspace, neighbourId);
+
+    bool flag = next->vis;
+    if (!flag && route != NULL) {
+      flag = isCityIdInRoute(route, neighbourId);
+      if (flag && neighbourId == finalId && currId != startId) {
+        flag = false;
+      }
+      if (flag && neighbourId == openId) {
+        flag = false;
+      }
+    }
+    if (flag) {
+      continue;
+    }
+
+    bool isImproved = false;
+
+    if (curr->dist + iter->length < next->dist) {
+      next->dist = curr->dist + iter->length;
+      next->prev = currId;
+      next->isCorrect = curr->isCorrect;
+
+      if (iter->builtYear < curr->minRepairYear) {
+        next->minRepairYear = iter->builtYear;
+        next->isCorrect = true;
+      } else {
+        next->minRepairYear = curr->minRepairYear;
+      }
+      isImproved = true;
+
+    } else if (curr->dist + iter->length == next->dist) {
+      if (iter->builtYear < curr->minRepairYear) {
+        if (iter->builtYear == next->minRepairYear) {
+          next->isCorrect = false;
+        } else if (iter->builtYear > next->minRepairYear) {
+          next->isCorrect = curr->isCorrect;
+          next->minRepairYear = iter->builtYear;
+          next->prev = currId;
+          isImproved = true;
+        }
+      } else {
+        if (curr->minRepairYear == next->minRepairYear) {
+          next->isCorrect = false;
+        } else if (curr->minRepairYear > next->minRepairYear) {
+          next->isCorrect = curr->isCorrect;
+          next->minRepairYear = curr->minRepairYear;
+          next->prev = currId;
+          isImproved = true;
+        }
+      }
+    }
+
+    if (isImproved &&
+        !pushHeap(workspace->queue, newHeapElem(next->dist,
+                                                next->minRepairYear,
+                                                neighbourId))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Przygotowuje wyszukiwanie z miasta @p startCity.
+static bool startSearch(Map *m, Trie *startCity) {
+  SearchWorkspace *workspace = m->workspace;
+  if (!prepareSearchWorkspace(workspace, m->numOfCities)) {
+    return false;
+  }
+
+  SearchLabel *start = getSearchLabel(workspace, startCity->id);
+  start->dist = 0;
+  start->isCorrect = true;
+
+  return pushHeap(workspace->queue, newHeapElem(0, INF, startCity->id));
+}
+
+// Zapisuje w @p spfaResult etykietę miasta @p finalCity.
+static bool fillSpfaResult(Map *m, SpfaResult *spfaResult, Trie *finalCity) {
+  SearchLabel *final = getSearchLabel(m->workspace, finalCity->id);
+  spfaResult->dist = final->dist;
+  spfaResult->isCorrect = final->isCorrect;
+  spfaResult->minYear = final->minRepairYear;
+
+  if (spfaResult->isCorrect) {
+    spfaResult->path = prevToCitiesList(m, finalCity);
+    if (spfaResult->path == NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
 SpfaResult *spfa(Map *m, unsigned routeId, Trie *startCity, Trie *finalCity) {
+  return boundedSpfa(m, routeId, startCity, finalCity, UNSIGNED_INF);
+}
+
+SpfaResult *boundedSpfa(Map *m, unsigned routeId, Trie *startCity,
+                        Trie *finalCity, unsigned maxLength) {
   SpfaResult *spfaResult = makeNewSpfaResult();
-  CitiesList *queue = makeNewCitiesList();
-
-  bool *vis = (bool *)malloc(m->numOfCities * sizeof(bool));
-  int *minRepairYear = (int *)malloc(m->numOfCities * sizeof(int));
-  unsigned *dist = (unsigned *)malloc(m->numOfCities * sizeof(unsigned));
-  bool *isCorrect = (bool *)malloc(m->numOfCities * sizeof(bool));
-  Trie **prev = (Trie **)malloc(m->numOfCities * sizeof(Trie *));
-
-  if (spfaResult == NULL || queue == NULL || vis == NULL ||
-      minRepairYear == NULL || dist == NULL || isCorrect == NULL ||
-      prev == NULL) {
-    deleteCitiesList(queue);
-    free(vis);
-    free(minRepairYear);
-    free(dist);
-    free(isCorrect);
-    free(prev);
-    deleteResult(spfaResult);
+  if (spfaResult == NULL) {
     return NULL;
   }
 
-  for (int i = 0; i < m->numOfCities; i++) {
-    vis[i] = false;
-    minRepairYear[i] = INF;
-    dist[i] = UNSIGNED_INF;
-    isCorrect[i] = false;
-    prev[i] = NULL;
+  if (!startSearch(m, startCity)) {
+    deleteResult(spfaResult);
+    return NULL;
   }
 
-  dist[startCity->id] = 0;
+  // Długości odcinków są dodatnie, więc w chwili zdjęcia miasta z kopca
+  // wszyscy jego poprzednicy na najkrótszych drogach są już przetworzeni,
+  // a jego etykieta (dist, minRepairYear, isCorrect) jest ostateczna.
+  // Pozostałe w kopcu miasta są co najmniej tak samo odległe, więc nie mogą
+  // już zmienić etykiety miasta końcowego i wyszukiwanie można zakończyć.
+  SearchWorkspace *workspace = m->workspace;
+  NationalRoute *route = routeId != 0 ? m->nationalRoutes[routeId] : NULL;
+  while (!isEmptyHeap(workspace->queue)) {
+    int currId = popHeap(workspace->queue).id;
+    SearchLabel *curr = getSearchLabel(workspace, currId);
+    if (curr->vis) {
+      continue;
+    }
+    if (curr->dist > maxLength) {
+      break;
+    }
+    curr->vis = true;
+    if (currId == finalCity->id) {
+      break;
+    }
+
+    if (!relaxRoads(m, route, currId, startCity->id, finalCity->id, -1)) {
+      deleteResult(spfaResult);
+      return NULL;
+    }
+  }
 
-  if (!addCitiesListNode(queue, startCity)) {
-    deleteCitiesList(queue);
-    free(vis);
-    free(minRepairYear);
-    free(dist);
-    free(isCorrect);
-    free(prev);
+  // miasto końcowe jest nieosiągalne albo dalsze niż @p maxLength
+  if (!getSearchLabel(workspace, finalCity->id)->vis) {
+    spfaResult->dist = UNSIGNED_INF;
+    return spfaResult;
+  }
+  if (!fillSpfaResult(m, spfaResult, finalCity)) {
     deleteResult(spfaResult);
     return NULL;
   }
+  return spfaResult;
+}
 
-  vis[startCity->id] = true;
-  isCorrect[startCity->id] = true;
+// Zdejmuje z kopca przestrzeni @p workspace elementy miast o ostatecznych
+// etykietach. Zwraca @p true, jeśli kopiec nie jest pusty.
+static bool dropSettled(SearchWorkspace *workspace) {
+  while (!isEmptyHeap(workspace->queue)) {
+    int id = topHeap(workspace->queue).id;
+    if (!getSearchLabel(workspace, id)->vis) {
+      return true;
+    }
+    popHeap(workspace->queue);
+  }
+  return false;
+}
 
-  while (!isEmptyCitiesList(queue)) {
-    CitiesListNode *city = getCitiesListFront(queue);
-    Trie *currCity = city->elem.city;
+// Rozwija najbliższe miasto jednej strony wyszukiwania dwukierunkowego,
+// uwzględniając tylko długości odcinków, i poprawia @p shortest o drogi
+// łączące się z etykietami drugiej strony. Odcinki łączące miasta
+// o ostatecznych etykietach po obu stronach są zapamiętywane.
+static bool expandSide(Map *m, SearchWorkspace *side, SearchWorkspace *other,
+                       unsigned *shortest) {
+  int currId = popHeap(side->queue).id;
+  SearchLabel *curr = getSearchLabel(side, currId);
+  curr->vis = true;
+
+  GraphRow *row = &m->graph->rows[currId];
+  GraphEdge *iter = m->graph->edges + row->begin;
+  GraphEdge *end = iter + row->degree;
+  for (; iter != end; iter++) {
+    unsigned dist = curr->dist + iter->length;
+    if (hasSearchLabel(other, iter->neighbour)) {
+      SearchLabel *joint = getSearchLabel(other, iter->neighbour);
+      unsigned long long length = (unsigned long long)dist + joint->dist;
+      if (length < *shortest) {
+        *shortest = (unsigned)length;
+      }
+      if (joint->vis && length <= *shortest &&
+          (!pushHeap(side->meetings, newHeapElem(length, 0, currId)) ||
+           !pushHeap(other->meetings,
+                     newHeapElem(length, 0, iter->neighbour)))) {
+        return false;
+      }
+    }
+
+    SearchLabel *next = getSearchLabel(side, iter->neighbour);
+    if (!next->vis && dist < next->dist) {
+      next->dist = dist;
+      if (!pushHeap(side->queue, newHeapElem(dist, 0, iter->neighbour))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
 
-    RoadsListNode *iter = currCity->roads->head->next;
-    while (isValidRoadsListNode(iter)) {
-      Trie *neighbour = iter->elem.city;
+// Przygotowuje przestrzeń @p workspace do wyszukiwania długości dróg z miasta
+// o numerze @p id.
+static bool startSide(Map *m, SearchWorkspace *workspace, int id) {
+  if (!prepareSearchWorkspace(workspace, m->numOfCities)) {
+    return false;
+  }
+  getSearchLabel(workspace, id)->dist = 0;
+  return pushHeap(workspace->queue, newHeapElem(0, 0, id));
+}
 
-      bool flag = false;
-      if (routeId != 0) {
-        flag = isCityInRoute(neighbour, m->nationalRoutes[routeId]);
-        if (flag && neighbour == finalCity && currCity != startCity) {
-          flag = false;
-        }
+// Oznacza w etykietach przestrzeni @p marks miasta, które leżą na drogach
+// długości @p shortest i mają ostateczne etykiety po stronie @p side.
+// Przechodzi od miejsc spotkania obu stron w kierunku początku strony.
+static bool markSide(Map *m, SearchWorkspace *side, SearchWorkspace *marks,
+                     unsigned shortest) {
+  Heap *queue = side->queue;
+  clearHeap(queue);
+  while (!isEmptyHeap(side->meetings) &&
+         topHeap(side->meetings).dist == shortest) {
+    int id = popHeap(side->meetings).id;
+    SearchLabel *label = getSearchLabel(side, id);
+    if (!label->isOnPath) {
+      label->isOnPath = true;
+      getSearchLabel(marks, id)->isOnPath = true;
+      if (!pushHeap(queue, newHeapElem(label->dist, 0, id))) {
+        return false;
       }
+    }
+  }
 
-      if (!flag) {
-        if (dist[currCity->id] + iter->elem.length < dist[neighbour->id]) {
-          dist[neighbour->id] = dist[currCity->id] + iter->elem.length;
-          prev[neighbour->id] = currCity;
-          isCorrect[neighbour->id] = isCorrect[currCity->id];
-
-          if (iter->elem.builtYear < minRepairYear[currCity->id]) {
-            minRepairYear[neighbour->id] = iter->elem.builtYear;
-            isCorrect[neighbour->id] = true;
-          } else {
-            minRepairYear[neighbour->id] = minRepairYear[currCity->id];
-          }
-
-          if (!vis[neighbour->id]) {
-            if (!addCitiesListNode(queue, neighbour)) {
-              deleteCitiesList(queue);
-              free(vis);
-              free(minRepairYear);
-              free(dist);
-              free(isCorrect);
-              free(prev);
-              deleteResult(spfaResult);
-              return NULL;
-            }
-            vis[neighbour->id] = true;
-          }
-
-        } else if (dist[currCity->id] + iter->elem.length ==
-                   dist[neighbour->id]) {
-          if (iter->elem.builtYear < minRepairYear[currCity->id]) {
-            if (iter->elem.builtYear == minRepairYear[neighbour->id]) {
-              isCorrect[neighbour->id] = false;
-            } else if (iter->elem.builtYear > minRepairYear[neighbour->id]) {
-              isCorrect[neighbour->id] = isCorrect[currCity->id];
-              minRepairYear[neighbour->id] = iter->elem.builtYear;
-              prev[neighbour->id] = currCity;
-            }
-          } else {
-            if (minRepairYear[currCity->id] == minRepairYear[neighbour->id]) {
-              isCorrect[neighbour->id] = false;
-            } else if (minRepairYear[currCity->id] >
-                       minRepairYear[neighbour->id]) {
-              isCorrect[neighbour->id] = isCorrect[currCity->id];
-              minRepairYear[neighbour->id] = minRepairYear[currCity->id];
-              prev[neighbour->id] = currCity;
-            }
-          }
-        }
+  while (!isEmptyHeap(queue)) {
+    int currId = popHeap(queue).id;
+    SearchLabel *curr = getSearchLabel(side, currId);
+
+    GraphRow *row = &m->graph->rows[currId];
+    GraphEdge *iter = m->graph->edges + row->begin;
+    GraphEdge *end = iter + row->degree;
+    for (; iter != end; iter++) {
+      SearchLabel *next = getSearchLabel(side, iter->neighbour);
+      if (!next->vis || next->isOnPath ||
+          next->dist + iter->length != curr->dist) {
+        continue;
+      }
+      next->isOnPath = true;
+      getSearchLabel(marks, iter->neighbour)->isOnPath = true;
+      if (!pushHeap(queue, newHeapElem(next->dist, 0, iter->neighbour))) {
+        return false;
       }
-      iter = iter->next;
     }
-    popFrontCitiesList(queue);
+  }
+  return true;
+}
+
+// Wyznacza długość najkrótszej drogi z miasta @p startCity do miasta
+// @p finalCity i oznacza w etykietach wyszukiwania wstecznego wszystkie
+// miasta leżące na najkrótszych drogach. Zwraca tę długość w @p shortest.
+static bool markShortestPaths(Map *m, Trie *startCity, Trie *finalCity,
+                              unsigned *shortest) {
+  SearchWorkspace *forward = m->workspace;
+  SearchWorkspace *backward = m->backWorkspace;
+  if (!startSide(m, forward, startCity->id) ||
+      !startSide(m, backward, finalCity->id)) {
+    return false;
   }
 
-  deleteCitiesList(queue);
-  free(vis);
+  // Gdy suma odległości najbliższych nierozwiniętych miast obu stron
+  // przekracza długość najkrótszej drogi, każde miasto na takiej drodze ma
+  // ostateczną etykietę po przynajmniej jednej stronie, a każda taka droga
+  // zawiera odcinek łączący obie strony.
+  *shortest = UNSIGNED_INF;
+  while (dropSettled(forward) && dropSettled(backward)) {
+    unsigned forwardDist = topHeap(forward->queue).dist;
+    unsigned backwardDist = topHeap(backward->queue).dist;
+    if ((unsigned long long)forwardDist + backwardDist > *shortest) {
+      break;
+    }
 
-  spfaResult->dist = dist[finalCity->id];
-  spfaResult->isCorrect = isCorrect[finalCity->id];
-  spfaResult->prev = prev;
-  spfaResult->minYear = minRepairYear[finalCity->id];
+    bool isExpanded = forwardDist <= backwardDist
+                          ? expandSide(m, forward, backward, shortest)
+                          : expandSide(m, backward, forward, shortest);
+    if (!isExpanded) {
+      return false;
+    }
+  }
 
-  free(minRepairYear);
-  free(dist);
-  free(isCorrect);
+  if (*shortest == UNSIGNED_INF) {
+    return true;
+  }
+  return markSide(m, backward, backward, *shortest) &&
+         markSide(m, forward, backward, *shortest);
+}
 
+SpfaResult *bidirectionalSearch(Map *m, Trie *startCity, Trie *finalCity) {
+  SpfaResult *spfaResult = makeNewSpfaResult();
+  if (spfaResult == NULL) {
+    return NULL;
+  }
+
+  unsigned shortest;
+  if (!markShortestPaths(m, startCity, finalCity, &shortest) ||
+      !startSearch(m, startCity)) {
+    deleteResult(spfaResult);
+    return NULL;
+  }
+
+  // Etykieta miasta końcowego zależy tylko od miast leżących na najkrótszych
+  // drogach, więc wystarczy rozwijać te miasta. Kolejność zdejmowania miast
+  // z kopca zależy tylko od ich etykiet, więc jest taka sama jak w funkcji
+  // spfa.
+  SearchWorkspace *workspace = m->workspace;
+  while (shortest != UNSIGNED_INF && !isEmptyHeap(workspace->queue)) {
+    int currId = popHeap(workspace->queue).id;
+    SearchLabel *curr = getSearchLabel(workspace, currId);
+    if (curr->vis) {
+      continue;
+    }
+    curr->vis = true;
+    if (currId == finalCity->id) {
+      break;
+    }
+    if (!getSearchLabel(m->backWorkspace, currId)->isOnPath) {
+      continue;
+    }
+
+    if (!relaxRoads(m, NULL, currId, startCity->id, finalCity->id, -1)) {
+      deleteResult(spfaResult);
+      return NULL;
+    }
+  }
+
+  if (!fillSpfaResult(m, spfaResult, finalCity)) {
+    deleteResult(spfaResult);
+    return NULL;
+  }
   return spfaResult;
 }
 
+SpfaResult *extendSearch(Map *m, unsigned routeId, Trie *city,
+                         SpfaResult **tailResult) {
+  NationalRoute *route = m->nationalRoutes[routeId];
+  Trie *headCity = getRouteSection(route, 0)->city;
+  Trie *tailCity = getRouteSection(route, getRouteLength(route) - 1)->city;
+
+  SpfaResult *headResult = makeNewSpfaResult();
+  if (headResult == NULL) {
+    return NULL;
+  }
+  if (!startSearch(m, city)) {
+    deleteResult(headResult);
+    return NULL;
+  }
+
+  // Końce drogi krajowej nie są rozwijane, więc droga do jednego z nich nie
+  // przechodzi przez drugi. Do początku drogi nie można wejść bezpośrednio
+  // z miasta @p city, tak jak w wyszukiwaniu z @p city do początku drogi.
+  SearchWorkspace *workspace = m->workspace;
+  int settled = 0;
+  while (!isEmptyHeap(workspace->queue) && settled < 2) {
+    int currId = popHeap(workspace->queue).id;
+    SearchLabel *curr = getSearchLabel(workspace, currId);
+    if (curr->vis) {
+      continue;
+    }
+    curr->vis = true;
+
+    if (currId == headCity->id || currId == tailCity->id) {
+      settled++;
+      continue;
+    }
+    if (!relaxRoads(m, route, currId, city->id, headCity->id,
+                    tailCity->id)) {
+      deleteResult(headResult);
+      return NULL;
+    }
+  }
+
+  if (!fillSpfaResult(m, headResult, headCity)) {
+    deleteResult(headResult);
+    return NULL;
+  }
+
+  // Długość i rok drogi do końca drogi krajowej nie zależą od kierunku,
+  // ale jednoznaczność już tak, więc wyszukiwanie od końca drogi krajowej
+  // jest potrzebne tylko wtedy, gdy jego wynik może zmienić wybór.
+  SearchLabel *tail = getSearchLabel(workspace, tailCity->id);
+  bool isHeadBetter =
+      headResult->isCorrect &&
+      (headResult->dist < tail->dist ||
+       (headResult->dist == tail->dist &&
+        headResult->minYear > tail->minRepairYear));
+  if (tail->dist == UNSIGNED_INF || isHeadBetter) {
+    *tailResult = makeNewSpfaResult();
+  } else {
+    *tailResult = spfa(m, routeId, tailCity, city);
+  }
+  if (*tailResult == NULL) {
+    deleteResult(headResult);
+    return NULL;
+  }
+  return headResult;
+}
+
 int getMinimalResult(SpfaResult *fstResult, SpfaResult *sndResult) {
   if (fstResult->isCorrect && sndResult->isCorrect) {
     if (fstResult->dist < sndResult->dist) {
@@ -480,68 +888,59 @@ int getMinimalResult(SpfaResult *fstResult, SpfaResult *sndResult) {
   }
 }
 
-void markRoadsWithRoute(CitiesList *list, unsigned routeId) {
-  CitiesListNode *iter = list->head->next;
-  while (isValidCitiesListNode(iter->next)) {
-    Trie *city = iter->elem.city;
-    Trie *neighbour = iter->next->elem.city;
+bool markRoadsWithRoute(NationalRoute *route, int begin, int end,
+                        unsigned routeId) {
+  for (int i = begin; i < end; i++) {
+    Road *road = getRouteSection(route, i)->road;
+    assert(road);
 
-    RoadsListNode *fstRoad = getRoadBetweenCities(city, neighbour);
-    RoadsListNode *sndRoad = getRoadBetweenCities(neighbour, city);
-
-    addRoutesListNode(fstRoad->elem.routes, routeId);
-    addRoutesListNode(sndRoad->elem.routes, routeId);
-
-    iter = iter->next;
+    RoutesListNode *mark = addRoutesListNode(road->routes, routeId);
+    if (mark == NULL) {
+      return false;
+    }
+    setRouteSectionMark(route, i, mark);
   }
+  return true;
 }
 
-void undoMarkRoadsWithRoute(CitiesList *list, unsigned routeId) {
-  assert(list);
-
-  CitiesListNode *iter = list->head->next;
-  assert(iter);
-  assert(iter->next);
-
-  while (isValidCitiesListNode(iter->next)) {
-    Trie *city = iter->elem.city;
-    Trie *neighbour = iter->next->elem.city;
-
-    RoadsListNode *fstRoad = getRoadBetweenCities(city, neighbour);
-    RoadsListNode *sndRoad = getRoadBetweenCities(neighbour, city);
-
-    removeRoutesListNodeById(fstRoad->elem.routes, routeId);
-    removeRoutesListNodeById(sndRoad->elem.routes, routeId);
+void undoMarkRoadsWithRoute(NationalRoute *route) {
+  assert(route);
 
-    iter = iter->next;
+  int length = getRouteLength(route);
+  for (int i = 0; i + 1 < length; i++) {
+    RouteSection *section = getRouteSection(route, i);
+    assert(section->road);
+    assert(section->mark);
+    removeRoutesListNode(section->road->routes, section->mark);
+    section->mark = NULL;
   }
 }
 
-bool addRoute(Map *m, unsigned routeId, Trie *cityPtr, Trie **prev) {
+bool addRoute(Map *m, unsigned routeId, CitiesList *list) {
   m->nationalRoutes[routeId] = newNationalRoute();
   if (m->nationalRoutes[routeId] == NULL) {
+    deleteCitiesList(list);
     return false;
   }
 
   NationalRoute *route = m->nationalRoutes[routeId];
   route->id = routeId;
 
-  CitiesList *list = prevToCitiesList(prev, cityPtr);
-  markRoadsWithRoute(list, routeId);
-  addAfterRouteSection(route->list->head, list);
-
-  return true;
+  if (!insertRouteSections(route, 0, list)) {
+    return false;
+  }
+  return markRoadsWithRoute(route, 0, getRouteLength(route) - 1, routeId);
 }
 
 bool isRouteinRoad(Trie *city, Trie *neighbour, unsigned routeId) {
   assert(city);
   assert(neighbour);
 
-  RoadsListNode *road = getRoadBetweenCities(city, neighbour);
-  assert(road->elem.routes);
+  Road *road = getRoadBetweenCities(city, neighbour);
+  assert(road->routes);
 
   int cnt = 0;
-  RoutesListNode *route = road->elem.routes->head->next;
+  RoutesListNode *route = road->routes->head->next;
   while (isValidRoutesListNode(route)) {
     if (route->elem.routeId == routeId) {
       cnt++;
@@ -553,51 +952,70 @@ bool isRouteinRoad(Trie *city, Trie *neighbour, unsigned routeId) {
   return cnt > 0;
 }
 
+// Sprawdza odcinek drogi krajowej wychodzący z miasta na pozycji @p position.
+static bool isValidRouteSection(NationalRoute *route, int position,
+                                unsigned routeId) {
+  RouteSection *section = getRouteSection(route, position);
+  Trie *city = section->city;
+  Trie *next = getRouteSection(route, position + 1)->city;
+
+  return isNeighbour(city, next) && isNeighbour(next, city) &&
+         section->road == getRoadBetweenCities(city, next) &&
+         isRouteinRoad(city, next, routeId) &&
+         isRouteinRoad(next, city, routeId) && section->mark != NULL &&
+         section->mark->elem.routeId == routeId &&
+         getMarkedRoutePosition(route, section->mark) == position;
+}
+
 bool checkRoute(Map *m, unsigned routeId) {
   assert(m);
   assert(m->nationalRoutes[routeId]);
 
   NationalRoute *route = m->nationalRoutes[routeId];
 
-  CitiesListNode *iter = route->list->head->next;
-  while (isValidCitiesListNode(iter->next)) {
-    assert(isNeighbour(iter->elem.city, iter->next->elem.city));
-    assert(isNeighbour(iter->next->elem.city, iter->elem.city));
-
-    assert(isRouteinRoad(iter->elem.city, iter->next->elem.city, routeId));
-    assert(isRouteinRoad(iter->next->elem.city, iter->elem.city, routeId));
-
-    iter = iter->next;
+  int length = getRouteLength(route);
+  for (int i = 0; i + 1 < length; i++) {
+    if (!isValidRouteSection(route, i, routeId)) {
+      return false;
+    }
   }
-
-  return true;
+  return getRouteSection(route, length - 1)->road == NULL;
 }
 
 bool newRoute(Map *map, unsigned routeId, const char *city1,
               const char *city2) {
   if (map == NULL) {
-    return NULL;
+    return false;
   }
-  if (routeId == 0 || routeId > 999) {
+  if (!isValidCityName(city1) || !isValidCityName(city2)) {
     return false;
   }
-  if (map->nationalRoutes[routeId] != NULL) {
+
+  return newRouteById(map, routeId, findCity(map, city1),
+                      findCity(map, city2));
+}
+
+bool newRouteById(Map *map, unsigned routeId, CityId city1, CityId city2) {
+  if (map == NULL) {
     return false;
   }
-  if (!isValidCityName(city1) || !isValidCityName(city2)) {
+  if (routeId == 0 || routeId > 999) {
     return false;
   }
-  if (strcmp(city1, city2) == 0) {
+  if (map->nationalRoutes[routeId] != NULL) {
     return false;
   }
-  if (getCityPtr(map, city1) == NULL || getCityPtr(map, city2) == NULL) {
+  if (city1 == city2) {
     return false;
   }
 
-  Trie *startCity = getCityPtr(map, city1);
-  Trie *finalCity = getCityPtr(map, city2);
+  Trie *startCity = getCityById(map, city1);
+  Trie *finalCity = getCityById(map, city2);
+  if (startCity == NULL || finalCity == NULL) {
+    return false;
+  }
 
-  SpfaResult *result = spfa(map, 0, startCity, finalCity);
+  SpfaResult *result = bidirectionalSearch(map, startCity, finalCity);
   if (result == NULL) {
     return false;
   }
@@ -607,7 +1025,8 @@ bool newRoute(Map *map, unsigned routeId, const char *city1,
     return false;
   }
 
-  bool res = addRoute(map, routeId, finalCity, result->prev);
+  bool res = addRoute(map, routeId, result->path);
+  result->path = NULL;
 
   assert(checkRoute(map, routeId));
 
@@ -627,7 +1046,7 @@ bool removeRoute(Map *map, unsigned routeId) {
     return false;
   }
 
-  undoMarkRoadsWithRoute(map->nationalRoutes[routeId]->list, routeId);
+  undoMarkRoadsWithRoute(map->nationalRoutes[routeId]);
 
   deleteNationalRoute(map->nationalRoutes[routeId]);
   map->nationalRoutes[routeId] = NULL;
@@ -639,17 +1058,25 @@ bool extendRoute(Map *map, unsigned routeId, const char *city) {
   if (map == NULL) {
     return false;
   }
-  if (routeId == 0 || routeId > 999) {
+  if (!isValidCityName(city)) {
     return false;
   }
-  if (!isValidCityName(city)) {
+
+  return extendRouteById(map, routeId, findCity(map, city));
+}
+
+bool extendRouteById(Map *map, unsigned routeId, CityId city) {
+  if (map == NULL) {
+    return false;
+  }
+  if (routeId == 0 || routeId > 999) {
     return false;
   }
   if (map->nationalRoutes[routeId] == NULL) {
     return false;
   }
 
-  Trie *cityPtr = getCityPtr(map, city);
+  Trie *cityPtr = getCityById(map, city);
   if (cityPtr == NULL) {
     return false;
   }
@@ -657,139 +1084,100 @@ bool extendRoute(Map *map, unsigned routeId, const char *city) {
     return false;
   }
 
-  Trie *fstStartCity =
-      map->nationalRoutes[routeId]->list->tail->prev->elem.city;
-  Trie *fstFinalCity = getCityPtr(map, city);
-
-  SpfaResult *fstResult = spfa(map, routeId, fstStartCity, fstFinalCity);
-  if (fstResult == NULL) {
-    return false;
-  }
-
-  Trie *sndStartCity = getCityPtr(map, city);
-  Trie *sndFinalCity =
-      map->nationalRoutes[routeId]->list->head->next->elem.city;
+  NationalRoute *route = map->nationalRoutes[routeId];
+  int length = getRouteLength(route);
 
-  SpfaResult *sndResult = spfa(map, routeId, sndStartCity, sndFinalCity);
+  SpfaResult *fstResult = NULL;
+  SpfaResult *sndResult = extendSearch(map, routeId, cityPtr, &fstResult);
   if (sndResult == NULL) {
     return false;
   }
 
+  bool res = true;
   int resultCase = getMinimalResult(fstResult, sndResult);
   if (resultCase == 0) {
     deleteResult(fstResult);
     deleteResult(sndResult);
     return false;
   } else if (resultCase == 1) {
-    CitiesList *list = prevToCitiesList(fstResult->prev, fstFinalCity);
-
-    markRoadsWithRoute(list, routeId);
+    CitiesList *list = fstResult->path;
+    fstResult->path = NULL;
 
     popFrontCitiesList(list);
 
-    addAfterRouteSection(map->nationalRoutes[routeId]->list->tail->prev, list);
+    if (!insertRouteSections(route, length, list)) {
+      deleteResult(fstResult);
+      deleteResult(sndResult);
+      return false;
+    }
+    res = markRoadsWithRoute(route, length - 1, getRouteLength(route) - 1,
+                             routeId);
   } else if (resultCase == 2) {
-    CitiesList *list = prevToCitiesList(sndResult->prev, sndFinalCity);
-
-    markRoadsWithRoute(list, routeId);
+    CitiesList *list = sndResult->path;
+    sndResult->path = NULL;
 
     popBackCitiesList(list);
 
-    addAfterRouteSection(map->nationalRoutes[routeId]->list->head, list);
+    if (!insertRouteSections(route, 0, list)) {
+      deleteResult(fstResult);
+      deleteResult(sndResult);
+      return false;
+    }
+    res = markRoadsWithRoute(route, 0, getRouteLength(route) - length, routeId);
   } else {
     assert(false);
   }
 
-  assert(checkRoute(map, routeId));
+  assert(!res || checkRoute(map, routeId));
 
   deleteResult(fstResult);
   deleteResult(sndResult);
 
-  return true;
+  return res;
 }
 
-bool isPossibleToReplaceRoadInRoute(Map *m, Trie *city1, Trie *city2,
-                                    unsigned routeId) {
+SpfaResult *searchRoadDetour(Map *m, RoutesListNode *mark,
+                             unsigned maxLength) {
   assert(m != NULL);
-  assert(m->nationalRoutes[routeId] != NULL);
-  assert(city1 != NULL);
-  assert(city2 != NULL);
+  assert(mark != NULL);
 
+  unsigned routeId = mark->elem.routeId;
   NationalRoute *route = m->nationalRoutes[routeId];
+  assert(route != NULL);
 
-  CitiesListNode *iter = route->list->head->next;
-
-  assert(iter);
-  assert(iter->next);
+  int position = getMarkedRoutePosition(route, mark);
+  Trie *currCity = getRouteSection(route, position)->city;
+  Trie *nextCity = getRouteSection(route, position + 1)->city;
 
-  while (isValidCitiesListNode(iter->next)) {
-    Trie *currCity = iter->elem.city;
-    Trie *nextCity = iter->next->elem.city;
-
-    if ((currCity == city1 && nextCity == city2) ||
-        (nextCity == city1 && currCity == city2)) {
-      SpfaResult *result = spfa(m, routeId, currCity, nextCity);
-
-      if (result == NULL) {
-        return false;
-      }
-
-      bool res = result->isCorrect;
-      deleteResult(result);
-      return res;
-    }
-    iter = iter->next;
-  }
-
-  assert(false);
-  return false;
+  return boundedSpfa(m, routeId, currCity, nextCity, maxLength);
 }
 
-bool replaceRoadInRoute(Map *m, Trie *city1, Trie *city2, unsigned routeId) {
+bool replaceRoadInRoute(Map *m, RoutesListNode *mark, CitiesList *list) {
   assert(m);
-  assert(m->nationalRoutes[routeId]);
-  assert(city1);
-  assert(city2);
+  assert(mark);
+  assert(list);
 
+  unsigned routeId = mark->elem.routeId;
   NationalRoute *route = m->nationalRoutes[routeId];
+  assert(route);
 
-  CitiesListNode *iter = route->list->head->next;
-
-  assert(iter);
-  assert(iter->next);
-
-  while (isValidCitiesListNode(iter->next)) {
-    Trie *currCity = iter->elem.city;
-    Trie *nextCity = iter->next->elem.city;
-
-    if ((currCity == city1 && nextCity == city2) ||
-        (nextCity == city1 && currCity == city2)) {
-      SpfaResult *result = spfa(m, routeId, currCity, nextCity);
-
-      if (result == NULL) {
-        return false;
-      }
-
-      CitiesList *list = prevToCitiesList(result->prev, nextCity);
-
-      markRoadsWithRoute(list, routeId);
-
-      assert(checkRoute(m, routeId));
-
-      popFrontCitiesList(list);
-      popBackCitiesList(list);
-
-      addAfterRouteSection(iter, list);
+  int position = getMarkedRoutePosition(route, mark);
 
-      deleteResult(result);
+  popFrontCitiesList(list);
+  popBackCitiesList(list);
 
-      return true;
-    }
-    iter = iter->next;
+  int length = getRouteLength(route);
+  if (!insertRouteSections(route, position + 1, list)) {
+    return false;
+  }
+  if (!markRoadsWithRoute(route, position,
+                          position + 1 + getRouteLength(route) - length,
+                          routeId)) {
+    return false;
   }
 
-  assert(false);
-  return false;
+  assert(checkRoute(m, routeId));
+  return true;
 }
 
 void removeRoadFromCity(Trie *city, Trie *neighbour) {
@@ -797,66 +1185,99 @@ void removeRoadFromCity(Trie *city, Trie *neighbour) {
   assert(neighbour);
   assert(isNeighbour(city, neighbour));
 
-  RoadsListNode *road = getRoadBetweenCities(city, neighbour);
+  removeRoadSection(city, neighbour);
+}
 
-  assert(road);
-  removeRoadsListNode(road);
+// Usuwa wyniki wyszukiwań objazdów o numerach od @p begin do @p end - 1
+// oraz tablicę @p detours.
+static void deleteDetours(SpfaResult **detours, int begin, int end) {
+  for (int i = begin; i < end; i++) {
+    deleteResult(detours[i]);
+  }
+  free(detours);
 }
 
 bool removeRoad(Map *map, const char *city1, const char *city2) {
+  return removeRoadWithDetourLimit(map, city1, city2, UNSIGNED_INF);
+}
+
+bool removeRoadWithDetourLimit(Map *map, const char *city1, const char *city2,
+                               unsigned maxDetourLength) {
   if (map == NULL) {
     return false;
   }
   if (!isValidCityName(city1) || !isValidCityName(city2)) {
     return false;
   }
-  if (strcmp(city1, city2) == 0) {
+
+  return removeRoadById(map, findCity(map, city1), findCity(map, city2),
+                        maxDetourLength);
+}
+
+bool removeRoadById(Map *map, CityId city1, CityId city2,
+                    unsigned maxDetourLength) {
+  if (city1 == city2) {
     return false;
   }
-  if (getCityPtr(map, city1) == NULL || getCityPtr(map, city2) == NULL) {
+
+  Trie *city1Ptr = getCityById(map, city1);
+  Trie *city2Ptr = getCityById(map, city2);
+  if (city1Ptr == NULL || city2Ptr == NULL) {
     return false;
   }
-
-  Trie *city1Ptr = getCityPtr(map, city1);
-  Trie *city2Ptr = getCityPtr(map, city2);
-  if (city1Ptr != NULL && city2Ptr != NULL) {
-    if (!isNeighbour(city1Ptr, city2Ptr)) {
-      return false;
-    }
-  } else {
+  if (!isNeighbour(city1Ptr, city2Ptr)) {
     return false;
   }
 
-  RoadsListNode *road = getRoadBetweenCities(city1Ptr, city2Ptr);
+  Road *road = getRoadBetweenCities(city1Ptr, city2Ptr);
   assert(road);
 
-  RoutesListNode *route = road->elem.routes->head->next;
-  assert(route);
+  int numOfRoutes = 0;
+  RoutesListNode *route = road->routes->head->next;
+  while (isValidRoutesListNode(route)) {
+    numOfRoutes++;
+    route = route->next;
+  }
 
+  // objazdy wyznaczone przy sprawdzaniu są potem wstawiane do dróg krajowych
+  SpfaResult **detours = NULL;
+  if (numOfRoutes > 0) {
+    detours = (SpfaResult **)malloc(numOfRoutes * sizeof(SpfaResult *));
+    if (detours == NULL) {
+      return false;
+    }
+  }
+
+  int numOfDetours = 0;
+  route = road->routes->head->next;
   while (isValidRoutesListNode(route)) {
-    bool result = isPossibleToReplaceRoadInRoute(map, city1Ptr, city2Ptr,
-                                                 route->elem.routeId);
-    if (result == false) {
+    SpfaResult *detour = searchRoadDetour(map, route, maxDetourLength);
+    if (detour == NULL || !detour->isCorrect) {
+      deleteResult(detour);
+      deleteDetours(detours, 0, numOfDetours);
       return false;
     }
+    detours[numOfDetours++] = detour;
     route = route->next;
   }
 
-  route = road->elem.routes->head->next;
-  assert(route);
-
+  int i = 0;
+  route = road->routes->head->next;
   while (isValidRoutesListNode(route)) {
-    if (!replaceRoadInRoute(map, city1Ptr, city2Ptr, route->elem.routeId)) {
+    CitiesList *path = detours[i]->path;
+    detours[i++]->path = NULL;
+    if (!replaceRoadInRoute(map, route, path)) {
+      deleteDetours(detours, 0, numOfDetours);
       return false;
     }
     route = route->next;
   }
+  deleteDetours(detours, 0, numOfDetours);
 
-  city1Ptr = getCityPtr(map, city1);
-  city2Ptr = getCityPtr(map, city2);
-
+  // odcinek jest zwalniany razem z ostatnim odwołaniem z listy dróg miasta
+  removeGraphEdge(map->graph, city1, *getRoadEdge(road, city1, city2));
+  removeGraphEdge(map->graph, city2, *getRoadEdge(road, city2, city1));
   removeRoadFromCity(city1Ptr, city2Ptr);
-  removeRoadFromCity(city2Ptr, city1Ptr);
 
   return true;
 }
@@ -8,9 +8,21 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
+#include "city_names.h"
+#include "defines.h"
 #include "national_route.h"
+#include "node_pool.h"
+#include "roads_graph.h"
+#include "route_writer.h"
+#include "search_workspace.h"
 #include "trie.h"
 
+/**
+ * Numer miasta, nadawany kolejno przy dodawaniu go do mapy. Wartość
+ * @ref NO_CITY oznacza brak miasta.
+ */
+typedef int CityId;
+
 /**
  * Struktura przechowująca mapę dróg krajowych.
  */
@@ -18,6 +30,13 @@ typedef struct Map {
   Trie *trie;  ///< struktura przechowująca nazwy miast oraz odcinki dróg
   NationalRoute **nationalRoutes;  ///< tablica przechowująca drogi krajowe
   int numOfCities;  ///< zmienna przechowująca liczbę miast dodanych do mapy
+  SearchWorkspace *workspace;  ///< pamięć współdzielona przez wyszukiwania
+  SearchWorkspace *backWorkspace;  ///< pamięć wyszukiwań od miasta końcowego
+  RoadsGraph *graph;  ///< zwarta kopia odcinków dróg, używana w wyszukiwaniach
+  Trie **cities;      ///< tablica miast, indeksowana ich numerami
+  int citiesCapacity;  ///< rozmiar tablicy @p cities
+  NodePools *pools;    ///< pule węzłów drzewa Trie, list i odcinków dróg
+  CityNames *names;    ///< nazwy miast, indeksowane ich numerami
 } Map;
 
 /** @brief Tworzy nową strukturę.
@@ -51,6 +70,22 @@ void deleteMap(Map *map);
 bool addRoad(Map *map, const char *city1, const char *city2, unsigned length,
              int builtYear);
 
+/** @brief Dodaje do mapy odcinek drogi między dwoma różnymi miastami.
+ * Działa jak @ref addRoad, ale miasta muszą już istnieć i są podane przez
+ * numery, więc nie są wyszukiwane po nazwach.
+ * @param[in,out] map    – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city1      – numer miasta;
+ * @param[in] city2      – numer miasta;
+ * @param[in] length     – długość w km odcinka drogi;
+ * @param[in] builtYear  – rok budowy odcinka drogi.
+ * @return Wartość @p true, jeśli odcinek drogi został dodany.
+ * Wartość @p false, jeśli wystąpił błąd: któryś z parametrów ma niepoprawną
+ * wartość, któreś z miast nie istnieje, oba numery są identyczne, odcinek
+ * drogi między tymi miastami już istnieje lub nie udało się zaalokować pamięci.
+ */
+bool addRoadById(Map *map, CityId city1, CityId city2, unsigned length,
+                 int builtYear);
+
 /** @brief Modyfikuje rok ostatniego remontu odcinka drogi.
  * Dla odcinka drogi między dwoma miastami zmienia rok jego ostatniego remontu
  * lub ustawia ten rok, jeśli odcinek nie był jeszcze remontowany.
@@ -66,6 +101,28 @@ bool addRoad(Map *map, const char *city1, const char *city2, unsigned length,
  */
 bool repairRoad(Map *map, const char *city1, const char *city2, int repairYear);
 
+/** @brief Modyfikuje rok ostatniego remontu odcinka drogi.
+ * Działa jak @ref repairRoad, ale miasta są podane przez numery.
+ * @param[in,out] map    – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city1      – numer miasta;
+ * @param[in] city2      – numer miasta;
+ * @param[in] repairYear – rok ostatniego remontu odcinka drogi.
+ * @return Wartość @p true, jeśli modyfikacja się powiodła.
+ * Wartość @p false w tych samych przypadkach co @ref repairRoad.
+ */
+bool repairRoadById(Map *map, CityId city1, CityId city2, int repairYear);
+
+/** @brief Ustawia rok ostatniego remontu odcinka drogi.
+ * Zmienia rok remontu odcinka drogi między miastami @p city1 i @p city2 w obu
+ * kierunkach, również w grafie wykorzystywanym przez wyszukiwania. Odcinek
+ * musi istnieć.
+ * @param[in,out] map    – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city1      – wskaźnik na pierwsze miasto;
+ * @param[in] city2      – wskaźnik na drugie miasto;
+ * @param[in] repairYear – rok ostatniego remontu odcinka drogi.
+ */
+void setRoadRepairYear(Map *map, Trie *city1, Trie *city2, int repairYear);
+
 /** @brief Łączy dwa różne miasta drogą krajową.
  * Tworzy drogę krajową pomiędzy dwoma miastami i nadaje jej podany numer.
  * Wśród istniejących odcinków dróg wyszukuje najkrótszą drogę. Jeśli jest
@@ -85,6 +142,17 @@ bool repairRoad(Map *map, const char *city1, const char *city2, int repairYear);
  */
 bool newRoute(Map *map, unsigned routeId, const char *city1, const char *city2);
 
+/** @brief Łączy dwa różne miasta drogą krajową.
+ * Działa jak @ref newRoute, ale miasta są podane przez numery.
+ * @param[in,out] map    – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] routeId    – numer drogi krajowej;
+ * @param[in] city1      – numer miasta;
+ * @param[in] city2      – numer miasta.
+ * @return Wartość @p true, jeśli droga krajowa została utworzona.
+ * Wartość @p false w tych samych przypadkach co @ref newRoute.
+ */
+bool newRouteById(Map *map, unsigned routeId, CityId city1, CityId city2);
+
 /** @brief Wydłuża drogę krajową do podanego miasta.
  * Dodaje do drogi krajowej nowe odcinki dróg do podanego miasta w taki sposób,
  * aby nowy fragment drogi krajowej był najkrótszy. Jeśli jest więcej niż jeden
@@ -104,6 +172,16 @@ bool newRoute(Map *map, unsigned routeId, const char *city1, const char *city2);
  */
 bool extendRoute(Map *map, unsigned routeId, const char *city);
 
+/** @brief Wydłuża drogę krajową do podanego miasta.
+ * Działa jak @ref extendRoute, ale miasto jest podane przez numer.
+ * @param[in,out] map    – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] routeId    – numer drogi krajowej;
+ * @param[in] city       – numer miasta.
+ * @return Wartość @p true, jeśli droga krajowa została wydłużona.
+ * Wartość @p false w tych samych przypadkach co @ref extendRoute.
+ */
+bool extendRouteById(Map *map, unsigned routeId, CityId city);
+
 /** @brief Usuwa odcinek drogi między dwoma różnymi miastami.
  * Usuwa odcinek drogi między dwoma miastami. Jeśli usunięcie tego odcinka drogi
  * powoduje przerwanie ciągu jakiejś drogi krajowej, to uzupełnia ją
@@ -123,6 +201,37 @@ bool extendRoute(Map *map, unsigned routeId, const char *city);
  */
 bool removeRoad(Map *map, const char *city1, const char *city2);
 
+/** @brief Usuwa odcinek drogi między dwoma różnymi miastami, jeśli objazdy
+ * nie są za długie.
+ * Działa jak @ref removeRoad, ale nie usuwa odcinka, jeśli któryś z objazdów
+ * uzupełniających drogi krajowe byłby dłuższy niż @p maxDetourLength.
+ * Wyszukiwanie objazdu nie wychodzi poza tę odległość, więc odrzucenie zbyt
+ * długiego objazdu nie wymaga przeszukiwania całej mapy.
+ * @param[in,out] map         – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city1           – wskaźnik na napis reprezentujący nazwę miasta;
+ * @param[in] city2           – wskaźnik na napis reprezentujący nazwę miasta;
+ * @param[in] maxDetourLength – największa dopuszczalna długość objazdu.
+ * @return Wartość @p true, jeśli odcinek drogi został usunięty.
+ * Wartość @p false w tych samych przypadkach co @ref removeRoad oraz wtedy,
+ * gdy któryś z objazdów byłby za długi.
+ */
+bool removeRoadWithDetourLimit(Map *map, const char *city1, const char *city2,
+                               unsigned maxDetourLength);
+
+/** @brief Usuwa odcinek drogi między dwoma różnymi miastami.
+ * Działa jak @ref removeRoadWithDetourLimit, ale miasta są podane przez
+ * numery.
+ * @param[in,out] map         – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city1           – numer miasta;
+ * @param[in] city2           – numer miasta;
+ * @param[in] maxDetourLength – największa dopuszczalna długość objazdu.
+ * @return Wartość @p true, jeśli odcinek drogi został usunięty.
+ * Wartość @p false w tych samych przypadkach co
+ * @ref removeRoadWithDetourLimit.
+ */
+bool removeRoadById(Map *map, CityId city1, CityId city2,
+                    unsigned maxDetourLength);
+
 /** @brief Usuwa z mapy dróg drogę krajową o podanym numerze.
  * @param[in,out] map - wskaźnik na strukturę przechowującą mapę dróg;
  * @param[in] routeId – numer drogi krajowej.
@@ -148,6 +257,32 @@ bool removeRoute(Map *map, unsigned routeId);
  */
 char const *getRouteDescription(Map *map, unsigned routeId);
 
+/** @brief Udostępnia zapamiętany opis drogi krajowej.
+ * Zwraca ten sam napis co @ref getRouteDescription, ale bez kopiowania go.
+ * Opis jest wyznaczany tylko przy pierwszym odczycie po zmianie drogi
+ * krajowej lub któregoś z jej odcinków. Napisu nie wolno zwalniać, a wskaźnik
+ * przestaje być poprawny po kolejnej modyfikacji mapy.
+ * @param[in,out] map    – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] routeId    – numer drogi krajowej;
+ * @param[out] length    – długość opisu.
+ * @return Wskaźnik na napis lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+const char *getCachedRouteDescription(Map *map, unsigned routeId,
+                                      size_t *length);
+
+/** @brief Zapisuje informacje o drodze krajowej do ujścia.
+ * Zapisuje ten sam napis co @ref getRouteDescription, bez kończącego znaku
+ * '\0'. Korzysta z zapamiętanego opisu drogi krajowej, a gdy nie da się go
+ * zapamiętać, wyznacza go bez alokowania pamięci. Nic nie zapisuje, jeśli nie
+ * istnieje droga krajowa o podanym numerze.
+ * @param[in,out] map    – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] routeId    – numer drogi krajowej;
+ * @param[in,out] sink   – wskaźnik na ujście.
+ * @return Wartość @p true, jeśli ujście przyjęło cały opis.
+ * Wartość @p false, jeśli ujście zgłosiło błąd.
+ */
+bool writeRouteDescription(Map *map, unsigned routeId, RouteSink *sink);
+
 /** @brief Zwraca wskaźnik do węzła reprezentującego miasto.
  * Jeśli miasto istnieje, zwraca do niego wskaźnik;
  * W przeciwnym razie zwraca NULL.
@@ -157,6 +292,48 @@ char const *getRouteDescription(Map *map, unsigned routeId);
  */
 Trie *getCityPtr(Map *map, const char *city);
 
+/** @brief Zwraca numer miasta o podanej nazwie.
+ * @param[in] map   – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city  – wskaźnik na napis reprezentujący nazwę miasta.
+ * @return Numer miasta lub @ref NO_CITY, gdy nazwa jest niepoprawna albo
+ * miasto nie istnieje.
+ */
+CityId lookupCity(Map *map, const char *city);
+
+/** @brief Zwraca numer miasta o podanej nazwie, dodając je w razie potrzeby.
+ * Jeśli miasto nie istnieje, to dodaje je do mapy.
+ * @param[in,out] map – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city    – wskaźnik na napis reprezentujący nazwę miasta.
+ * @return Numer miasta lub @ref NO_CITY, gdy nazwa jest niepoprawna albo nie
+ * udało się zaalokować pamięci.
+ */
+CityId internCity(Map *map, const char *city);
+
+/** @brief Zwraca numer miasta o nazwie sprawdzonej już przez wywołującego.
+ * Działa jak @ref lookupCity, ale nie sprawdza poprawności nazwy.
+ * @param[in] map   – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city  – wskaźnik na poprawną nazwę miasta.
+ * @return Numer miasta lub @ref NO_CITY, gdy miasto nie istnieje.
+ */
+CityId lookupCityUnchecked(Map *map, const char *city);
+
+/** @brief Zwraca numer miasta o nazwie sprawdzonej już przez wywołującego,
+ * dodając je w razie potrzeby.
+ * Działa jak @ref internCity, ale nie sprawdza poprawności nazwy.
+ * @param[in,out] map – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city    – wskaźnik na poprawną nazwę miasta.
+ * @return Numer miasta lub @ref NO_CITY, gdy nie udało się zaalokować
+ * pamięci.
+ */
+CityId internCityUnchecked(Map *map, const char *city);
+
+/** @brief Zwraca wskaźnik do węzła reprezentującego miasto o podanym numerze.
+ * @param[in] map   – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] city  – numer miasta.
+ * @return Wskaźnik do miasta lub NULL, gdy miasto nie istnieje.
+ */
+Trie *getCityById(Map *map, CityId city);
+
 /** @brief Dodaje miasto do mapy.
  * @param[in,out] map - wskaźnik na strukturę przechowującą mapę dróg;
  * @param[in] city  – wskaźnik na napis.
@@ -165,38 +342,8 @@ Trie *getCityPtr(Map *map, const char *city);
  */
 bool addCity(Map *map, const char *city);
 
-/** @brief Łączy dwa stringi w jeden.
- * Do stringa wskazywanego przez @p str dodaje nazwę miasta
- * wskazywanego przez @p city.
- * @param[in,out] str - wskaźnik na napis;
- * @param[in] strLength  – długość napisu;
- * @param[in] pos  – numer ostatniego dodanego znaku;
- * @param[in] city  – wskaźnik na miasto.
- */
-void concatenateCityNameToResult(char **str, size_t *strLength,
-                                 unsigned int *pos, Trie *city);
-
-/** @brief Łączy dwa stringi w jeden.
- * Do stringa wskazywanego przez @p str dodaje wartość @p val.
- * @param[in,out] str - wskaźnik na napis;
- * @param[in] strLength  – długość napisu;
- * @param[in] pos  – numer ostatniego dodanego znaku;
- * @param[in] val  – liczba.
- */
-void concatenateIntToResult(char **str, size_t *strLength, unsigned int *pos,
-                            int val);
-
-/** @brief Łączy dwa stringi w jeden.
- * Do stringa wskazywanego przez @p str dodaje wartość @p val.
- * @param[in,out] str - wskaźnik na napis;
- * @param[in] strLength  – długość napisu;
- * @param[in] pos  – numer ostatniego dodanego znaku;
- * @param[in] val  – liczba.
- */
-void concatenateUnsignedToResult(char **str, size_t *strLength,
-                                 unsigned int *pos, unsigned val);
-
 /** @brief Sprawdza, czy dane miasto jest częścią danej drogi krajowej.
+ * Korzysta ze zbioru miast drogi krajowej, więc działa w czasie stałym.
  * @param[in] city  – wskaźnik na miasto;
  * @param[in] route  – wskaźnik na drogę krajową.
  * @return Wartość @p true, jeśli dane miasto jest częścią drogi krajowej.
@@ -204,13 +351,14 @@ void concatenateUnsignedToResult(char **str, size_t *strLength,
  */
 bool isCityInRoute(Trie *city, NationalRoute *route);
 
-/** @brief Zamienia tablicę prev na listę miast.
- * @param[in] prev  – wskaźnik na tablicę;
+/** @brief Zamienia wyznaczone w ostatnim wyszukiwaniu poprzedniki na listę
+ * miast.
+ * @param[in] m  – wskaźnik na strukturę przechowującą mapę dróg;
  * @param[in] cityPtr  – wskaźnik na miasto.
  * @return Wskaźnik na listę miast lub NULL,
  * gdy działanie się nie powiodło.
  */
-CitiesList *prevToCitiesList(Trie **prev, Trie *cityPtr);
+CitiesList *prevToCitiesList(Map *m, Trie *cityPtr);
 
 /**
  * Struktura przechowująca wynik funkcji spfa.
@@ -219,7 +367,7 @@ typedef struct SpfaResult {
   unsigned dist;   ///< dlugosc drogi
   bool isCorrect;  ///< informacja, czy droga jest poprawna
   int minYear;     ///< minimalny rok budowy na drodze
-  Trie **prev;     ///< tablica przodków
+  CitiesList *path;  ///< znaleziona droga lub NULL, gdy nie jest poprawna
 
 } SpfaResult;
 
@@ -237,6 +385,13 @@ void deleteResult(SpfaResult *result);
 
 /** @brief Wyszukuje najkrótszą drogę z miasta @p startCity
  * do miasta @p finalCity.
+ * Korzysta z algorytmu Dijkstry z kopcem, uporządkowanym według długości
+ * drogi, a następnie malejąco według roku najstarszego odcinka, dzięki czemu
+ * każde miasto jest przetwarzane dokładnie raz.
+ * Wyszukiwanie kończy się w chwili zdjęcia z kopca miasta @p finalCity.
+ * Etykiety miast są przechowywane w przestrzeni roboczej mapy i nie są
+ * czyszczone między wywołaniami, więc koszt wyszukiwania zależy od liczby
+ * odwiedzonych miast, a nie od rozmiaru mapy.
  * @param[in] m  – wskaźnik na strukturę przechowującą mapę dróg;
  * @param[in] routeId  – numer drogi krajowej;
  * @param[in] startCity – wskaźnik na miasto startowe;
@@ -245,6 +400,52 @@ void deleteResult(SpfaResult *result);
  */
 SpfaResult *spfa(Map *m, unsigned routeId, Trie *startCity, Trie *finalCity);
 
+/** @brief Wyszukuje najkrótszą drogę z miasta @p startCity do miasta
+ * @p finalCity, nie dłuższą niż @p maxLength.
+ * Działa jak @ref spfa, ale nie rozwija miast odległych o więcej niż
+ * @p maxLength. Jeśli miasto @p finalCity jest dalej, to wynik oznacza
+ * niepoprawną drogę.
+ * @param[in] m  – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] routeId  – numer drogi krajowej;
+ * @param[in] startCity – wskaźnik na miasto startowe;
+ * @param[in] finalCity – wskaźnik na miasto końcowe;
+ * @param[in] maxLength – największa dopuszczalna długość drogi.
+ * @return Wskaźnik na wynik lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+SpfaResult *boundedSpfa(Map *m, unsigned routeId, Trie *startCity,
+                        Trie *finalCity, unsigned maxLength);
+
+/** @brief Wyszukuje najkrótszą drogę z miasta @p startCity
+ * do miasta @p finalCity dla nowej drogi krajowej.
+ * Najpierw wyszukiwanie prowadzone jednocześnie od obu miast wyznacza
+ * długość najkrótszej drogi, a potem algorytm Dijkstry z miasta
+ * @p startCity rozwija tylko miasta, które mogą leżeć na takiej drodze.
+ * Wynik jest taki sam jak wynik funkcji @ref spfa dla drogi krajowej o numerze
+ * 0, ale na dużych mapach odwiedzanych jest znacznie mniej miast.
+ * @param[in] m  – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] startCity – wskaźnik na miasto startowe;
+ * @param[in] finalCity – wskaźnik na miasto końcowe.
+ * @return Wskaźnik na wynik lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+SpfaResult *bidirectionalSearch(Map *m, Trie *startCity, Trie *finalCity);
+
+/** @brief Wyszukuje oba warianty wydłużenia drogi krajowej do miasta @p city.
+ * Jedno wyszukiwanie z miasta @p city wyznacza drogę do początku drogi
+ * krajowej oraz długość i rok drogi do jej końca. Wyszukiwanie od końca drogi
+ * krajowej do miasta @p city, rozstrzygające o jednoznaczności tej drogi,
+ * jest uruchamiane tylko wtedy, gdy może zmienić wynik
+ * @ref getMinimalResult; wpp. @p tailResult oznacza niepoprawną drogę.
+ * @param[in] m  – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] routeId  – numer drogi krajowej;
+ * @param[in] city – wskaźnik na miasto, do którego wydłużana jest droga;
+ * @param[out] tailResult – wynik dla drogi od końca drogi krajowej do
+ * miasta @p city.
+ * @return Wynik dla drogi od miasta @p city do początku drogi krajowej lub
+ * NULL, gdy nie udało się zaalokować pamięci.
+ */
+SpfaResult *extendSearch(Map *m, unsigned routeId, Trie *city,
+                         SpfaResult **tailResult);
+
 /** @brief Porównuje dwa wyniki działania funkcji spfa
  * i wybiera pośród nich najlepszy.
  * @param[in] fstResult  – wskaźnik na strukturę przechowującą mapę dróg;
@@ -255,29 +456,34 @@ SpfaResult *spfa(Map *m, unsigned routeId, Trie *startCity, Trie *finalCity);
  */
 int getMinimalResult(SpfaResult *fstResult, SpfaResult *sndResult);
 
-/** @brief Oznacza drogi między miastami na liście @p list,
- * jako należące do drogi krajowej o numerze @p routeId.
- * @param[in] list - wskaźnik na listę miast;
- * @param[in] routeId  – numer drogi krajowej.
+/** @brief Oznacza odcinki dróg wychodzące z miast na pozycjach od @p begin
+ * do @p end - 1 drogi krajowej jako należące do drogi krajowej o numerze
+ * @p routeId i zapamiętuje w odcinkach drogi krajowej dodane węzły.
+ * @param[in,out] route – wskaźnik na drogę krajową;
+ * @param[in] begin     – pozycja pierwszego miasta;
+ * @param[in] end       – pozycja za ostatnim miastem;
+ * @param[in] routeId   – numer drogi krajowej.
+ * @return Wartość @p true, jeśli udało się oznaczyć odcinki.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
  */
-void markRoadsWithRoute(CitiesList *list, unsigned routeId);
+bool markRoadsWithRoute(NationalRoute *route, int begin, int end,
+                        unsigned routeId);
 
-/** @brief Odznacza drogi między miastami na liście @p list,
- * jako należące do drogi krajowej o numerze @p routeId.
- * @param[in] list - wskaźnik na listę miast;
- * @param[in] routeId  – numer drogi krajowej.
+/** @brief Odznacza wszystkie odcinki dróg drogi krajowej @p route,
+ * jako należące do tej drogi krajowej.
+ * @param[in,out] route – wskaźnik na drogę krajową.
  */
-void undoMarkRoadsWithRoute(CitiesList *list, unsigned routeId);
+void undoMarkRoadsWithRoute(NationalRoute *route);
 
 /** @brief Dodaje drogę krajową.
+ * Przejmuje na własność listę @p list.
  * @param[in,out] m      – wskaźnik na strukturę przechowującą mapę dróg;
  * @param[in] routeId    – numer drogi krajowej;
- * @param[in] cityPtr    – wskaźnik na miasto końcowe;
- * @param[in] prev       – wskaźnik na tablicę poprzednich miast.
+ * @param[in] list       – wskaźnik na listę miast drogi krajowej.
  * @return Wartość @p true, jeśli droga krajowa została dodana.
  * Wartość @p false, jeśli nie udało się zaalokować pamięci.
  */
-bool addRoute(Map *m, unsigned routeId, Trie *cityPtr, Trie **prev);
+bool addRoute(Map *m, unsigned routeId, CitiesList *list);
 
 /** @brief Sprawdza, czy dana droga krajowa przechodzi przez dane miasto.
  * @param[in] city  – wskaźnik na miasto;
@@ -296,33 +502,33 @@ bool isRouteinRoad(Trie *city, Trie *neighbour, unsigned routeId);
  */
 bool checkRoute(Map *m, unsigned routeId);
 
-/** @brief Sprawdza, czy usunięci danej drogi nie spowoduje zepsucia danej
- * drogi krajowej.
- * @param[in,out] m – wskaźnik na strukturę przechowującą mapę dróg;
- * @param[in] city1  – wskaźnik na pierwsze miasto;
- * @param[in] city2  – wskaźnik na drugie miasto;
- * @param[in] routeId  – numer drogi krajowej.
- * @return Wartość @p true, jeśli usunięcie drogi nie zepuje drogi krajowej;
- * Wpp wartość @p false.
+/** @brief Wyszukuje objazd odcinka drogi krajowej.
+ * Wyszukuje najkrótszą drogę pomiędzy końcami odcinka drogi krajowej
+ * wskazanego przez węzeł @p mark z listy dróg krajowych usuwanej drogi.
+ * Usunięcie drogi nie zepsuje drogi krajowej, jeśli wynik jest poprawny.
+ * Objazd dłuższy niż @p maxLength nie jest wyszukiwany.
+ * @param[in,out] m     – wskaźnik na strukturę przechowującą mapę dróg;
+ * @param[in] mark      – węzeł drogi krajowej na liście dróg krajowych drogi;
+ * @param[in] maxLength – największa dopuszczalna długość objazdu.
+ * @return Wskaźnik na wynik lub NULL, gdy nie udało się zaalokować pamięci.
  */
-bool isPossibleToReplaceRoadInRoute(Map *m, Trie *city1, Trie *city2,
-                                    unsigned routeId);
+SpfaResult *searchRoadDetour(Map *m, RoutesListNode *mark,
+                             unsigned maxLength);
 
-/** @brief Uzupełnia drogę krajową pomiędzy miastami.
- * Wyszukuje najkrótszą drogę pomiędzy miastami @p city1 i @p city2;
- * Uzupełnia drogę krajową o numerze @p routeId nowo znalezioną drogą
- * pomiędzy podanymi miastami.
+/** @brief Uzupełnia drogę krajową objazdem.
+ * Wstawia objazd @p list, wyznaczony przez @ref searchRoadDetour, do drogi
+ * krajowej w miejsce odcinka wskazanego przez węzeł @p mark. Przejmuje na
+ * własność listę @p list.
  * @param[in,out] m – wskaźnik na strukturę przechowującą mapę dróg;
- * @param[in] city1  – wskaźnik na pierwsze miasto;
- * @param[in] city2  – wskaźnik na drugie miasto;
- * @param[in] routeId  – numer drogi krajowej.
+ * @param[in] mark  – węzeł drogi krajowej na liście dróg krajowych drogi;
+ * @param[in] list  – lista miast objazdu, łącznie z końcami odcinka.
  * @return Wartość @p false, jeśli nie udało się zaalokować pamięci;
  * Wpp wartość @p true.
  */
-bool replaceRoadInRoute(Map *m, Trie *city1, Trie *city2, unsigned routeId);
+bool replaceRoadInRoute(Map *m, RoutesListNode *mark, CitiesList *list);
 
 /** @brief Usuwa drogę pomiędzy miastami.
- * Usuwa drogę wychodzącą z miasta @p city1 do miasta @p city2.
+ * Usuwa odcinek drogi z list dróg obu miast.
  * @param[in] city – wskaźnik na miasto;
  * @param[in] neighbour – wskaźnik na sąsiada.
  */
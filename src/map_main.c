@@ -1,329 +1,306 @@
 #include <assert.h>
-#include <errno.h>
 #include <stdbool.h>
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "defines.h"
+#include "line_fields.h"
+#include "line_reader.h"
 #include "map.h"
 #include "national_route.h"
+#include "output_writer.h"
 #include "roads_list.h"
 #include "strings.h"
 
 // Wywoływana przed zakończeniem programu, zwalnia całą pamięć
-void clean(char **line, Map **m) {
-  free(*line);
+void clean(LineReader **reader, Map **m) {
+  deleteLineReader(*reader);
   deleteMap(*m);
 }
 
-// Wywoływana na początek programu, alokuje potrzebną pamięć
-void initialize(char **line, size_t *lineLength, Map **m) {
-  *lineLength = INITIAL_LINE_LENGTH;
-  *line = malloc(*lineLength * sizeof(char));
+// Wywoływana na początek programu, alokuje potrzebną pamięć. Polecenia są
+// wczytywane z pliku @p path, a jeśli jest on równy NULL, to ze
+// standardowego wejścia.
+void initialize(LineReader **reader, Map **m, const char *path) {
+  *reader = path != NULL ? openLineReader(path) : newLineReader(STDIN_FILENO);
   *m = newMap();
-  if (*line == NULL || *m == NULL) {
-    clean(line, m);
-    exit(0);
+  if (*reader == NULL || *m == NULL) {
+    clean(reader, m);
+    exit(path != NULL && *reader == NULL ? 1 : 0);
   }
 }
 
-// Wczytuje linię ze standardowego wejścia
-int readLine(char **line, size_t *lineLength, Map **m) {
-  int character;
-  unsigned int pos = 0;
-
-  while ((character = fgetc(stdin)) != '\n' && character != EOF) {
-    if (pos + 1 >= *lineLength) {
-      *lineLength *= 2;
-      *line = realloc(*line, *lineLength * sizeof(char));
-      if (*line == NULL) {
-        clean(line, m);
-        exit(0);
-      }
-    }
-
-    // Jeśli na wejściu pojawi się '\0', zmieniam go na inny niepoprawny
-    // znak po to, aby nie sygnalizował on końca stringa
-    if (character == '\0') {
-      character = (char)1;
-    }
+// Dodaje drogę krajową o numerze @p routeId, opisaną przez pola wiersza
+// następujące po numerze. Zwraca @p false, jeśli opis jest niepoprawny.
+bool addRouteDefinition(LineFields *fields, unsigned routeId, Map *m) {
+  LineField *args = fields->fields + 1;
+  unsigned int pos = (unsigned int)fields->count - 1;
 
-    (*line)[pos++] = (char)character;
+  if (pos < 4 || (pos - 1) % 3 != 0) {
+    return false;
   }
 
-  // zastępuję ostatni znak w linii znakiem końca stringa
-  (*line)[pos] = '\0';
-
-  return character != EOF;
-}
-
-// Wykonuje operacje dla danej linii
-void processLine(char *line, int lineNumber, Map *m) {
-  size_t numOfCharacters = strlen(line) + 1;
-
-  // komentarze lub pusty wiersz
-  if (numOfCharacters == 1 || line[0] == '#') {
-    return;
+  if (m->nationalRoutes[routeId] != NULL) {
+    return false;
   }
 
-  // wiersz zaczyna się średnikiem
-  if (line[0] == ';') {
-    fprintf(stderr, "ERROR %d\n", lineNumber);
-    return;
-  }
-
-  char *command = strtok(line, ";\n");  // typ operacji
-
-  unsigned routeId = strGetRouteId(command);
-  if (0 < routeId && routeId < 1000) {
-    size_t argsLength = INITIAL_LINE_LENGTH;
-    char **args = malloc(argsLength * sizeof(char *));
-    if (args == NULL) {
-      clean(&line, &m);
-      exit(0);
+  // sprawdzanie poprawnosci nazw miast, dalej nie trzeba ich już sprawdzać
+  for (unsigned int i = 0; i < pos; i += 3) {
+    if (args[i].hasControlChars) {
+      return false;
     }
+  }
 
-    unsigned int pos = 0;
-
-    char *arg;
-    size_t expectedLength = strlen(command) + 1;
-
-    while ((arg = strtok(NULL, ";\n")) != NULL) {
-      expectedLength += strlen(arg) + 1;
-
-      if (pos + 1 >= argsLength) {
-        argsLength *= 2;
-        args = realloc(args, sizeof(char *) * argsLength);
-
-        if (args == NULL) {
-          fprintf(stderr, "ERROR %d\n", lineNumber);
-          return;
-        }
+  // sprawdzanie cyklu
+  for (unsigned int i = 0; i < pos; i += 3) {
+    for (unsigned j = 0; j < i; j += 3) {
+      if (args[i].length == args[j].length &&
+          memcmp(args[i].chars, args[j].chars, args[i].length) == 0) {
+        return false;
       }
-
-      args[pos++] = arg;
     }
+  }
 
-    if (numOfCharacters != expectedLength) {
-      fprintf(stderr, "ERROR %d\n", lineNumber);
-      free(args);
-      return;
-    }
+  CityId *ids = malloc((pos / 3 + 1) * sizeof(CityId));
+  if (ids == NULL) {
+    return false;
+  }
+  for (unsigned int i = 0; i < pos; i += 3) {
+    ids[i / 3] = lookupCityUnchecked(m, args[i].chars);
+  }
 
-    if (pos < 4 || (pos - 1) % 3 != 0) {
-      fprintf(stderr, "ERROR %d\n", lineNumber);
-      free(args);
-      return;
-    }
+  // sprawdzanie poprawności dlugości i roku budowy
+  for (unsigned int i = 0; i < pos - 3; i += 3) {
+    unsigned length = strGetLength(args[i + 1].chars);
+    int year = strGetYear(args[i + 2].chars);
 
-    if (m->nationalRoutes[routeId] != NULL) {
-      fprintf(stderr, "ERROR %d\n", lineNumber);
-      free(args);
-      return;
+    if (length == 0 || year == 0) {
+      free(ids);
+      return false;
     }
 
-    // sprawdzanie poprawnosci nazw miast
-    for (unsigned int i = 0; i < pos; i += 3) {
-      if (!isValidCityName(args[i])) {
-        fprintf(stderr, "ERROR %d\n", lineNumber);
-        free(args);
-        return;
+    Trie *city1Ptr = getCityById(m, ids[i / 3]);
+    Trie *city2Ptr = getCityById(m, ids[i / 3 + 1]);
+    if (isNeighbour(city1Ptr, city2Ptr)) {
+      if (length != getRoadLength(city1Ptr, city2Ptr)) {
+        free(ids);
+        return false;
       }
-    }
-
-    // sprawdzanie cyklu
-    for (unsigned int i = 0; i < pos; i += 3) {
-      for (unsigned j = 0; j < i; j += 3) {
-        if (strcmp(args[i], args[j]) == 0) {
-          fprintf(stderr, "ERROR %d\n", lineNumber);
-          free(args);
-          return;
-        }
+      if (year < getRepairYear(city1Ptr, city2Ptr)) {
+        free(ids);
+        return false;
       }
     }
+  }
 
-    // sprawdzanie poprawności dlugości i roku budowy
-    for (unsigned int i = 0; i < pos - 3; i += 3) {
-      unsigned length = strGetLength(args[i + 1]);
-      int year = strGetYear(args[i + 2]);
-
-      if (length == 0 || year == 0) {
-        fprintf(stderr, "ERROR %d\n", lineNumber);
-        free(args);
-        return;
-      }
+  m->nationalRoutes[routeId] = newNationalRoute();
+  if (m->nationalRoutes[routeId] == NULL) {
+    free(ids);
+    return false;
+  }
 
-      Trie *city1Ptr = getCityPtr(m, args[i]);
-      Trie *city2Ptr = getCityPtr(m, args[i + 3]);
-      if (isNeighbour(city1Ptr, city2Ptr)) {
-        if (length != getRoadLength(city1Ptr, city2Ptr)) {
-          fprintf(stderr, "ERROR %d\n", lineNumber);
-          free(args);
-          return;
-        }
-        if (year < getRepairYear(city1Ptr, city2Ptr)) {
-          fprintf(stderr, "ERROR %d\n", lineNumber);
-          free(args);
-          return;
-        }
-      }
+  for (unsigned int i = 0; i < pos; i += 3) {
+    if (ids[i / 3] == NO_CITY) {
+      ids[i / 3] = internCityUnchecked(m, args[i].chars);
     }
+  }
 
-    m->nationalRoutes[routeId] = newNationalRoute();
-    if (m->nationalRoutes[routeId] == NULL) {
-      fprintf(stderr, "ERROR %d\n", lineNumber);
-      free(args);
-      return;
+  m->nationalRoutes[routeId]->id = routeId;
+  for (unsigned int i = 0; i < pos - 3; i += 3) {
+    unsigned length = strGetLength(args[i + 1].chars);
+    int year = strGetYear(args[i + 2].chars);
+
+    Trie *city1Ptr = getCityById(m, ids[i / 3]);
+    Trie *city2Ptr = getCityById(m, ids[i / 3 + 1]);
+    if (isNeighbour(city1Ptr, city2Ptr)) {
+      setRoadRepairYear(m, city1Ptr, city2Ptr, year);
+    } else {
+      addRoadById(m, ids[i / 3], ids[i / 3 + 1], length, year);
     }
 
-    m->nationalRoutes[routeId]->id = routeId;
-    for (unsigned int i = 0; i < pos - 3; i += 3) {
-      unsigned length = strGetLength(args[i + 1]);
-      int year = strGetYear(args[i + 2]);
-
-      Trie *city1Ptr = getCityPtr(m, args[i]);
-      Trie *city2Ptr = getCityPtr(m, args[i + 3]);
-      if (isNeighbour(city1Ptr, city2Ptr)) {
-        repairRoadSection(city1Ptr, city2Ptr, year);
-        repairRoadSection(city2Ptr, city1Ptr, year);
-      } else {
-        addRoad(m, args[i], args[i + 3], length, year);
-      }
-
-      city1Ptr = getCityPtr(m, args[i]);
-      city2Ptr = getCityPtr(m, args[i + 3]);
-      assert(getRoadBetweenCities(city1Ptr, city2Ptr));
-
-      addNationalRouteSection(m->nationalRoutes[routeId],
-                              getCityPtr(m, args[i]));
-
-      RoadsListNode *fstRoad = getRoadBetweenCities(city1Ptr, city2Ptr);
-      RoadsListNode *sndRoad = getRoadBetweenCities(city2Ptr, city1Ptr);
+    assert(getRoadBetweenCities(city1Ptr, city2Ptr));
 
-      addRoutesListNode(fstRoad->elem.routes, routeId);
-      addRoutesListNode(sndRoad->elem.routes, routeId);
-    }
-
-    addNationalRouteSection(m->nationalRoutes[routeId],
-                            getCityPtr(m, args[pos - 1]));
+    addNationalRouteSection(m->nationalRoutes[routeId], city1Ptr);
+  }
 
-    assert(checkRoute(m, routeId));
-    free(args);
-  } else {
-    size_t commandLength = 0, arg1Length = 0, arg2Length = 0, arg3Length = 0,
-           arg4Length = 0;
+  addNationalRouteSection(m->nationalRoutes[routeId],
+                          getCityById(m, ids[pos / 3]));
+  markRoadsWithRoute(m->nationalRoutes[routeId], 0, pos / 3, routeId);
 
-    char *arg1 = strtok(NULL, ";\n");  // pierwszy argument
-    char *arg2 = strtok(NULL, ";\n");  // drugi argument
-    char *arg3 = strtok(NULL, ";\n");  // trzeci argument
-    char *arg4 = strtok(NULL, ";\n");  // czwarty argument
-    char *rest = strtok(NULL, ";\n");  // jeśli jest coś jeszcze
+  assert(checkRoute(m, routeId));
+  free(ids);
+  return true;
+}
 
-    if (command != NULL) {
-      commandLength = strlen(command) + 1;
-    }
-    if (arg1 != NULL) {
-      arg1Length = strlen(arg1) + 1;
-    }
-    if (arg2 != NULL) {
-      arg2Length = strlen(arg2) + 1;
-    }
-    if (arg3 != NULL) {
-      arg3Length = strlen(arg3) + 1;
-    }
-    if (arg4 != NULL) {
-      arg4Length = strlen(arg4) + 1;
-    }
+// Sprawdza, czy pole @p field jest równe napisowi @p keyword o tej samej
+// długości.
+bool isKeyword(LineField *field, const char *keyword) {
+  return memcmp(field->chars, keyword, field->length) == 0;
+}
 
-    size_t expectedLength =
-        commandLength + arg1Length + arg2Length + arg3Length + arg4Length;
+// Przekazuje fragment opisu drogi krajowej do bufora wyjścia. Nie zgłasza
+// błędów zapisu, bo zapamiętuje je bufor, a polecenie zostało wykonane.
+bool writeRouteChunk(void *data, const char *chunk, size_t length) {
+  writeOutput((OutputWriter *)data, chunk, length);
+  return true;
+}
 
-    if (rest != NULL || numOfCharacters != expectedLength) {
-      fprintf(stderr, "ERROR %d\n", lineNumber);
-      return;
-    }
+// Wykonuje polecenie zapisane w polach wiersza, a odpowiedź dopisuje do
+// bufora @p out. Zwraca @p false, jeśli polecenie jest niepoprawne lub nie
+// udało się go wykonać.
+bool executeCommand(LineFields *fields, Map *m, OutputWriter *out) {
+  if (fields->count > 5) {
+    return false;
+  }
 
-    bool flag = true;
-    if (strcmp(command, "addRoad") == 0) {
-      unsigned length = strGetLength(arg3);
-      int builtYear = strGetYear(arg4);
-      flag = (!addRoad(m, arg1, arg2, length, builtYear));
-    } else if (strcmp(command, "removeRoad") == 0) {
-      flag = (arg3 != NULL);
-      if (!flag) {
-        flag = (!removeRoad(m, arg1, arg2));
+  char *args[4] = {NULL, NULL, NULL, NULL};
+  for (size_t i = 1; i < fields->count; i++) {
+    args[i - 1] = fields->fields[i].chars;
+  }
+  char *arg1 = args[0], *arg2 = args[1], *arg3 = args[2], *arg4 = args[3];
+
+  LineField *command = &fields->fields[0];
+  unsigned routeId;
+  switch (command->length) {
+    case 7:
+      if (isKeyword(command, "addRoad")) {
+        unsigned length = strGetLength(arg3);
+        int builtYear = strGetYear(arg4);
+        return addRoad(m, arg1, arg2, length, builtYear);
       }
-    } else if (strcmp(command, "repairRoad") == 0) {
-      int repairYear = strGetYear(arg3);
-      flag = (repairYear == 0 || arg4 != NULL);
-      if (!flag) {
-        flag = (!repairRoad(m, arg1, arg2, repairYear));
+      break;
+    case 8:
+      if (isKeyword(command, "newRoute")) {
+        routeId = strGetRouteId(arg1);
+        if (routeId == 0 || routeId > 999 || arg4 != NULL) {
+          return false;
+        }
+        return newRoute(m, routeId, arg2, arg3);
       }
-    } else if (strcmp(command, "newRoute") == 0) {
-      routeId = strGetRouteId(arg1);
-      flag = (routeId == 0 || routeId > 999 || arg4 != NULL);
-      if (!flag) {
-        flag = (!newRoute(m, routeId, arg2, arg3));
+      break;
+    case 10:
+      if (isKeyword(command, "removeRoad")) {
+        return arg3 == NULL && removeRoad(m, arg1, arg2);
       }
-    } else if (strcmp(command, "removeRoute") == 0) {
-      routeId = strGetRouteId(arg1);
-      flag = (arg2 != NULL);
-      if (!flag) {
-        flag = (!removeRoute(m, routeId));
+      if (isKeyword(command, "repairRoad")) {
+        int repairYear = strGetYear(arg3);
+        if (repairYear == 0 || arg4 != NULL) {
+          return false;
+        }
+        return repairRoad(m, arg1, arg2, repairYear);
       }
-    } else if (strcmp(command, "extendRoute") == 0) {
-      routeId = strGetRouteId(arg1);
-      flag = (arg3 != NULL);
-      if (!flag) {
-        flag = (!extendRoute(m, routeId, arg2));
+      break;
+    case 11:
+      if (isKeyword(command, "removeRoute")) {
+        routeId = strGetRouteId(arg1);
+        return arg2 == NULL && removeRoute(m, routeId);
       }
-    } else if (strcmp(command, "getRouteDescription") == 0) {
-      if (!strIsValidNumber(arg1) || arg1[0] == '-') {
-        fprintf(stderr, "ERROR %d\n", lineNumber);
-        return;
+      if (isKeyword(command, "extendRoute")) {
+        routeId = strGetRouteId(arg1);
+        return arg3 == NULL && extendRoute(m, routeId, arg2);
       }
+      break;
+    case 19:
+      if (isKeyword(command, "getRouteDescription")) {
+        long long num;
+        bool overflow;
+        if (!strParseNumber(arg1, &num, &overflow) || arg1[0] == '-' ||
+            overflow || num > MAX_ROUTE_ID) {
+          return false;
+        }
 
-      long long num = strtoll(arg1, NULL, 10);
-      if (errno == ERANGE || num > MAX_ROUTE_ID) {
-        errno = 0;
-        fprintf(stderr, "ERROR %d\n", lineNumber);
-        return;
-      }
+        routeId = (unsigned)num;
+        if (arg2 != NULL || arg3 != NULL || arg4 != NULL) {
+          return false;
+        }
 
-      routeId = strGetRouteId(arg1);
+        RouteSink sink = callbackRouteSink(writeRouteChunk, out);
+        writeRouteDescription(m, routeId, &sink);
+        writeOutput(out, "\n", 1);
+        return true;
+      }
+      break;
+  }
+  return false;
+}
 
-      flag = (arg2 != NULL || arg3 != NULL || arg4 != NULL);
-      if (!flag) {
-        const char *routeDescription = getRouteDescription(m, routeId);
+// Wykonuje operacje dla danej linii. Odpowiedzi trafiają do bufora @p out,
+// a komunikaty o błędach do bufora @p err.
+void processLine(LineFields *fields, char *line, size_t length,
+                 int lineNumber, Map *m, OutputWriter *out,
+                 OutputWriter *err) {
+  // komentarze lub pusty wiersz
+  if (length == 0 || line[0] == '#') {
+    return;
+  }
 
-        flag = (routeDescription == NULL);
-        if (!flag) {
-          fprintf(stdout, "%s\n", routeDescription);
-          free((void *)routeDescription);
-        }
-      }
-    }
+  // puste pole, w tym średnik na początku lub na końcu wiersza
+  if (!splitLine(fields, line, length) || fields->hasEmptyField) {
+    writeLineError(err, lineNumber);
+    return;
+  }
 
-    if (flag) {
-      fprintf(stderr, "ERROR %d\n", lineNumber);
-    }
+  unsigned routeId = strGetRouteId(fields->fields[0].chars);
+  bool isDone = 0 < routeId && routeId < 1000
+                    ? addRouteDefinition(fields, routeId, m)
+                    : executeCommand(fields, m, out);
+  if (!isDone) {
+    writeLineError(err, lineNumber);
   }
 }
 
-int main() {
-  size_t lineLength;
-  char *line;
+// Opróżnia bufory wyjścia, najpierw odpowiedzi, a potem błędów. Zwraca
+// @p false, jeśli któryś zapis się nie powiódł, teraz lub wcześniej.
+bool flushWriters(OutputWriter *out, OutputWriter *err) {
+  bool isOutWritten = flushOutput(out);
+  bool isErrWritten = flushOutput(err);
+  return isOutWritten && isErrWritten;
+}
+
+// Program można wywołać jako "map [-i] [plik]". W trybie interaktywnym,
+// włączanym opcją -i lub gdy wejście albo wyjście jest terminalem, bufory
+// wyjścia są opróżniane po każdym wierszu, a wpp. dopiero po zapełnieniu lub
+// na końcu wejścia. Jeśli nie udało się zapisać odpowiedzi lub komunikatów
+// o błędach, program kończy się kodem 1.
+int main(int argc, char **argv) {
+  bool isInteractive = argc > 1 && strcmp(argv[1], "-i") == 0;
+  int pathIndex = isInteractive ? 2 : 1;
+  const char *path = argc > pathIndex ? argv[pathIndex] : NULL;
+  if ((path == NULL && isatty(STDIN_FILENO)) || isatty(STDOUT_FILENO)) {
+    isInteractive = true;
+  }
 
-  Map *m = newMap();
-  initialize(&line, &lineLength, &m);
+  LineReader *reader;
+  Map *m;
+  initialize(&reader, &m, path);
+
+  LineFields *fields = newLineFields();
+  OutputWriter *out = newOutputWriter(STDOUT_FILENO);
+  OutputWriter *err = newOutputWriter(STDERR_FILENO);
+  if (fields == NULL || out == NULL || err == NULL) {
+    deleteOutputWriter(out);
+    deleteOutputWriter(err);
+    deleteLineFields(fields);
+    clean(&reader, &m);
+    return 0;
+  }
 
+  char *line;
+  size_t lineLength;
   int lineNumber = 1;
-  while (readLine(&line, &lineLength, &m)) {
-    processLine(line, lineNumber, m);
+  while (nextLine(reader, &line, &lineLength)) {
+    processLine(fields, line, lineLength, lineNumber, m, out, err);
+    if (isInteractive) {
+      flushWriters(out, err);
+    }
     lineNumber++;
   }
 
-  clean(&line, &m);
-  return 0;
+  bool isWritten = flushWriters(out, err);
+  deleteOutputWriter(out);
+  deleteOutputWriter(err);
+  deleteLineFields(fields);
+  clean(&reader, &m);
+  return isWritten ? 0 : 1;
 }
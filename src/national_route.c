@@ -1,9 +1,13 @@
 #include "national_route.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "defines.h"
+#include "trie.h"
+
 NationalRoute *newNationalRoute() {
   NationalRoute *nationalRoute = (NationalRoute *)malloc(sizeof(NationalRoute));
   if (nationalRoute == NULL) {
@@ -11,12 +15,15 @@ NationalRoute *newNationalRoute() {
   }
 
   nationalRoute->id = 0;
-  nationalRoute->list = makeNewCitiesList();
-  if (nationalRoute->list == NULL) {
-    free(nationalRoute);
-    return NULL;
-  }
-
+  nationalRoute->sections = NULL;
+  nationalRoute->sectionsCapacity = 0;
+  nationalRoute->gapBegin = 0;
+  nationalRoute->gapEnd = 0;
+  nationalRoute->members = NULL;
+  nationalRoute->membersCapacity = 0;
+  nationalRoute->numOfMembers = 0;
+  nationalRoute->description = NULL;
+  nationalRoute->descriptionLength = 0;
   return nationalRoute;
 }
 
@@ -24,9 +31,9 @@ void deleteNationalRoute(NationalRoute *nationalRoute) {
   if (nationalRoute == NULL) {
     return;
   }
-  if (nationalRoute->list != NULL) {
-    deleteCitiesList(nationalRoute->list);
-  }
+  free(nationalRoute->sections);
+  free(nationalRoute->members);
+  free(nationalRoute->description);
   free(nationalRoute);
 }
 
@@ -40,23 +47,241 @@ void deleteNationalRoutes(NationalRoute **nationalRoutes) {
   free(nationalRoutes);
 }
 
-bool addNationalRouteSection(NationalRoute *nationalRoute, void *city) {
-  return addCitiesListNode(nationalRoute->list, city);
+// Zwraca pozycję, od której szukamy numeru @p id w tablicy o rozmiarze
+// @p capacity, będącym potęgą dwójki.
+static int hashCityId(int id, int capacity) {
+  uint32_t hash = (uint32_t)id * 2654435769U;
+  return (int)((hash ^ hash >> 16) & (uint32_t)(capacity - 1));
 }
 
-void addAfterRouteSection(CitiesListNode *node, CitiesList *list) {
-  if (isEmptyCitiesList(list)) {
-    deleteCitiesList(list);
+// Zwraca miejsce numeru @p id w tablicy @p members lub wolne miejsce, w które
+// należy go wpisać.
+static int *findMemberSlot(int *members, int capacity, int id) {
+  int pos = hashCityId(id, capacity);
+  while (members[pos] != NO_CITY && members[pos] != id) {
+    pos = (pos + 1) & (capacity - 1);
+  }
+  return &members[pos];
+}
+
+// Powiększa zbiór miast drogi krajowej tak, aby zmieściło się w nim
+// @p count kolejnych numerów. Tablica jest zapełniona co najwyżej w połowie.
+static bool reserveRouteMembers(NationalRoute *nationalRoute, int count) {
+  int needed = 2 * (nationalRoute->numOfMembers + count);
+  if (needed <= nationalRoute->membersCapacity) {
+    return true;
+  }
+
+  int capacity = INITIAL_MEMBERS_CAPACITY;
+  while (capacity < needed) {
+    capacity *= 2;
+  }
+
+  int *members = (int *)malloc(capacity * sizeof(int));
+  if (members == NULL) {
+    return false;
+  }
+  for (int i = 0; i < capacity; i++) {
+    members[i] = NO_CITY;
+  }
+  for (int i = 0; i < nationalRoute->membersCapacity; i++) {
+    int id = nationalRoute->members[i];
+    if (id != NO_CITY) {
+      *findMemberSlot(members, capacity, id) = id;
+    }
+  }
+
+  free(nationalRoute->members);
+  nationalRoute->members = members;
+  nationalRoute->membersCapacity = capacity;
+  return true;
+}
+
+// Dodaje numer @p id do zbioru miast drogi krajowej, w którym musi być na
+// niego miejsce.
+static void markRouteMember(NationalRoute *nationalRoute, int id) {
+  int *slot = findMemberSlot(nationalRoute->members,
+                             nationalRoute->membersCapacity, id);
+  if (*slot == NO_CITY) {
+    *slot = id;
+    nationalRoute->numOfMembers++;
+  }
+}
+
+bool isCityIdInRoute(NationalRoute *nationalRoute, int id) {
+  if (nationalRoute->numOfMembers == 0) {
+    return false;
+  }
+  return *findMemberSlot(nationalRoute->members,
+                         nationalRoute->membersCapacity, id) == id;
+}
+
+void invalidateRouteDescription(NationalRoute *nationalRoute) {
+  if (nationalRoute == NULL) {
     return;
   }
+  free(nationalRoute->description);
+  nationalRoute->description = NULL;
+  nationalRoute->descriptionLength = 0;
+}
+
+int getRouteLength(NationalRoute *nationalRoute) {
+  return nationalRoute->sectionsCapacity -
+         (nationalRoute->gapEnd - nationalRoute->gapBegin);
+}
 
-  node->next->prev = list->tail->prev;
-  list->tail->prev->next = node->next;
+RouteSection *getRouteSection(NationalRoute *nationalRoute, int position) {
+  if (position >= nationalRoute->gapBegin) {
+    position += nationalRoute->gapEnd - nationalRoute->gapBegin;
+  }
+  return &nationalRoute->sections[position];
+}
 
-  node->next = list->head->next;
-  list->head->next->prev = node;
+int getMarkedRoutePosition(NationalRoute *nationalRoute, RoutesListNode *mark) {
+  int position = mark->elem.section;
+  if (position >= nationalRoute->gapEnd) {
+    position -= nationalRoute->gapEnd - nationalRoute->gapBegin;
+  }
+  return position;
+}
 
-  free(list->head);
-  free(list->tail);
-  free(list);
+void setRouteSectionMark(NationalRoute *nationalRoute, int position,
+                         RoutesListNode *mark) {
+  RouteSection *section = getRouteSection(nationalRoute, position);
+  section->mark = mark;
+  mark->elem.section = (int)(section - nationalRoute->sections);
+}
+
+// Poprawia indeksy odcinków o indeksach od @p begin do @p end - 1.
+static void updateSectionMarks(NationalRoute *nationalRoute, int begin,
+                               int end) {
+  for (int i = begin; i < end; i++) {
+    if (nationalRoute->sections[i].mark != NULL) {
+      nationalRoute->sections[i].mark->elem.section = i;
+    }
+  }
+}
+
+// Powiększa przerwę tak, aby mieściła @p count miast.
+static bool reserveRouteGap(NationalRoute *nationalRoute, int count) {
+  int gap = nationalRoute->gapEnd - nationalRoute->gapBegin;
+  if (gap >= count) {
+    return true;
+  }
+
+  int length = getRouteLength(nationalRoute);
+  int capacity = nationalRoute->sectionsCapacity > 0
+                     ? nationalRoute->sectionsCapacity
+                     : INITIAL_ROUTE_CAPACITY;
+  while (capacity < length + count) {
+    capacity *= 2;
+  }
+
+  RouteSection *sections = (RouteSection *)realloc(
+      nationalRoute->sections, capacity * sizeof(RouteSection));
+  if (sections == NULL) {
+    return false;
+  }
+
+  // miasta za przerwą przenosimy na koniec powiększonej tablicy
+  int suffix = nationalRoute->sectionsCapacity - nationalRoute->gapEnd;
+  memmove(sections + capacity - suffix, sections + nationalRoute->gapEnd,
+          suffix * sizeof(RouteSection));
+  nationalRoute->sections = sections;
+  nationalRoute->gapEnd = capacity - suffix;
+  nationalRoute->sectionsCapacity = capacity;
+  updateSectionMarks(nationalRoute, nationalRoute->gapEnd, capacity);
+  return true;
+}
+
+// Przesuwa przerwę tak, aby zaczynała się na pozycji @p position.
+static void moveRouteGap(NationalRoute *nationalRoute, int position) {
+  RouteSection *sections = nationalRoute->sections;
+  if (position < nationalRoute->gapBegin) {
+    int count = nationalRoute->gapBegin - position;
+    nationalRoute->gapEnd -= count;
+    memmove(sections + nationalRoute->gapEnd, sections + position,
+            count * sizeof(RouteSection));
+    updateSectionMarks(nationalRoute, nationalRoute->gapEnd,
+                       nationalRoute->gapEnd + count);
+  } else {
+    int count = position - nationalRoute->gapBegin;
+    memmove(sections + nationalRoute->gapBegin,
+            sections + nationalRoute->gapEnd, count * sizeof(RouteSection));
+    updateSectionMarks(nationalRoute, nationalRoute->gapBegin,
+                       nationalRoute->gapBegin + count);
+    nationalRoute->gapEnd += count;
+  }
+  nationalRoute->gapBegin = position;
+}
+
+bool addNationalRouteSection(NationalRoute *nationalRoute, void *city) {
+  invalidateRouteDescription(nationalRoute);
+
+  int id = ((Trie *)city)->id;
+  if (!reserveRouteMembers(nationalRoute, 1)) {
+    return false;
+  }
+  if (!reserveRouteGap(nationalRoute, 1)) {
+    return false;
+  }
+
+  int length = getRouteLength(nationalRoute);
+  moveRouteGap(nationalRoute, length);
+  if (length > 0) {
+    RouteSection *last = getRouteSection(nationalRoute, length - 1);
+    last->road = getRoadBetweenCities(last->city, city);
+  }
+
+  RouteSection *section = &nationalRoute->sections[nationalRoute->gapBegin++];
+  section->city = city;
+  section->road = NULL;
+  section->mark = NULL;
+  markRouteMember(nationalRoute, id);
+  return true;
+}
+
+bool insertRouteSections(NationalRoute *nationalRoute, int position,
+                         CitiesList *list) {
+  invalidateRouteDescription(nationalRoute);
+
+  int count = 0;
+  CitiesListNode *iter = list->head->next;
+  while (isValidCitiesListNode(iter)) {
+    count++;
+    iter = iter->next;
+  }
+  if (count == 0) {
+    deleteCitiesList(list);
+    return true;
+  }
+  if (!reserveRouteMembers(nationalRoute, count) ||
+      !reserveRouteGap(nationalRoute, count)) {
+    deleteCitiesList(list);
+    return false;
+  }
+
+  moveRouteGap(nationalRoute, position);
+  iter = list->head->next;
+  while (isValidCitiesListNode(iter)) {
+    RouteSection *section =
+        &nationalRoute->sections[nationalRoute->gapBegin++];
+    section->city = iter->elem.city;
+    section->road = NULL;
+    section->mark = NULL;
+    markRouteMember(nationalRoute, ((Trie *)iter->elem.city)->id);
+    iter = iter->next;
+  }
+  deleteCitiesList(list);
+
+  // odcinki od miasta przed wstawionym fragmentem do miasta za nim
+  int length = getRouteLength(nationalRoute);
+  int begin = position > 0 ? position - 1 : 0;
+  int end = position + count < length ? position + count : length - 1;
+  for (int i = begin; i < end; i++) {
+    RouteSection *section = getRouteSection(nationalRoute, i);
+    section->road = getRoadBetweenCities(
+        section->city, getRouteSection(nationalRoute, i + 1)->city);
+  }
+  return true;
 }
@@ -6,15 +6,42 @@
 #define __NATIONAL_ROUTE_H__
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "cities_list.h"
+#include "roads_list.h"
 
 /**
- * Struktura przechowująca drogę krajową.
+ * Miasto na drodze krajowej wraz z odcinkiem drogi do następnego miasta.
+ */
+typedef struct RouteSection {
+  void *city;  ///< wskaźnik na węzeł miasta
+  Road *road;  ///< odcinek do następnego miasta lub NULL dla ostatniego miasta
+  RoutesListNode *mark;  ///< węzeł tej drogi krajowej na liście odcinka @p road
+} RouteSection;
+
+/**
+ * Struktura przechowująca drogę krajową. Miasta są zapisane po kolei
+ * w tablicy @p sections, w której fragment [@p gapBegin, @p gapEnd) jest
+ * nieużywaną przerwą. Przerwa jest przesuwana w miejsce wstawiania, więc
+ * kolejne wstawienia w pobliżu tego samego miejsca są tanie. Węzeł drogi
+ * krajowej na liście dróg krajowych odcinka zna indeks tego odcinka
+ * w tablicy @p sections, a indeks ten jest poprawiany przy każdym
+ * przesunięciu odcinka. Numery miast są dodatkowo zapisane w tablicy
+ * haszującej z adresowaniem otwartym, której rozmiar zależy od długości
+ * drogi krajowej, a nie od liczby miast w mapie.
  */
 typedef struct NationalRoute {
-  int id;            ///< id drogi krajowej
-  CitiesList *list;  ///< lista miast na drodze krajowej
+  int id;                  ///< id drogi krajowej
+  RouteSection *sections;  ///< tablica miast drogi krajowej z przerwą
+  int sectionsCapacity;    ///< rozmiar tablicy @p sections
+  int gapBegin;            ///< początek przerwy
+  int gapEnd;              ///< koniec przerwy
+  int *members;            ///< tablica haszująca numerów miast drogi krajowej
+  int membersCapacity;     ///< rozmiar tablicy @p members
+  int numOfMembers;        ///< liczba numerów w tablicy @p members
+  char *description;  ///< zapamiętany opis drogi krajowej lub NULL
+  size_t descriptionLength;  ///< długość zapamiętanego opisu
 } NationalRoute;
 
 /** @brief Tworzy strukturę.
@@ -38,20 +65,77 @@ void deleteNationalRoute(NationalRoute *nationalRoute);
  */
 void deleteNationalRoutes(NationalRoute **nationalRoute);
 
+/** @brief Unieważnia zapamiętany opis drogi krajowej.
+ * Należy ją wywołać po każdej zmianie miast drogi krajowej lub odcinków dróg,
+ * przez które ona przechodzi. Nic nie robi, jeśli wskaźnik @p nationalRoute
+ * ma wartość NULL.
+ * @param[in,out] nationalRoute – wskaźnik na drogę krajową.
+ */
+void invalidateRouteDescription(NationalRoute *nationalRoute);
+
+/** @brief Zwraca liczbę miast na drodze krajowej.
+ * @param[in] nationalRoute – wskaźnik na drogę krajową.
+ * @return Liczba miast.
+ */
+int getRouteLength(NationalRoute *nationalRoute);
+
+/** @brief Zwraca miasto na pozycji @p position drogi krajowej.
+ * Wskaźnik przestaje być poprawny po zmianie drogi krajowej.
+ * @param[in] nationalRoute – wskaźnik na drogę krajową;
+ * @param[in] position – numer miasta na drodze, licząc od zera.
+ * @return Wskaźnik na miasto wraz z odcinkiem do następnego miasta.
+ */
+RouteSection *getRouteSection(NationalRoute *nationalRoute, int position);
+
+/** @brief Zwraca pozycję odcinka, do którego należy węzeł @p mark.
+ * Działa w czasie stałym.
+ * @param[in] nationalRoute – wskaźnik na drogę krajową;
+ * @param[in] mark – węzeł drogi krajowej na liście dróg krajowych odcinka.
+ * @return Pozycja miasta, z którego wychodzi odcinek, licząc od zera.
+ */
+int getMarkedRoutePosition(NationalRoute *nationalRoute, RoutesListNode *mark);
+
+/** @brief Zapisuje węzeł drogi krajowej na liście dróg krajowych odcinka
+ * wychodzącego z miasta na pozycji @p position.
+ * @param[in,out] nationalRoute – wskaźnik na drogę krajową;
+ * @param[in] position – numer miasta na drodze, licząc od zera;
+ * @param[in,out] mark – węzeł na liście dróg krajowych odcinka.
+ */
+void setRouteSectionMark(NationalRoute *nationalRoute, int position,
+                         RoutesListNode *mark);
+
 /** @brief Dodaje segment drogi krajowej.
- * Dodaje element do drogi krajowej wskazywanej przez @p nationalRoute
- * Nic nie robi, jeśli wskaźnik ten ma wartość NULL.
+ * Dodaje miasto na koniec drogi krajowej wskazywanej przez
+ * @p nationalRoute i zapisuje je w zbiorze jej miast. Odcinek drogi między
+ * dotychczas ostatnim miastem a nowym miastem musi istnieć.
  * @param[in] nationalRoute – wskaźnik na strukturę.
  * @param[in] city - wskaźnik na odpowiadający miastu węzeł.
+ * @return Wartość @p true, jeśli udało się dodać segment.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
  */
 bool addNationalRouteSection(NationalRoute *nationalRoute, void *city);
 
-/** @brief Dodaje listę wierzchołków do drogi krajowej.
- * Dodaje listę za elementem @p node.
- * Nic nie robi, jeśli lista jest pusta.
- * @param[in] node – wskaźnik na wierzchołek w liście drogi krajowej;
- * @param[in] list - wskaźnik na dodawaną listę.
+/** @brief Wstawia listę miast do drogi krajowej.
+ * Wstawia miasta z listy przed miasto na pozycji @p position, zapisuje je
+ * w zbiorze miast drogi krajowej i wyznacza odcinki dróg między sąsiednimi
+ * miastami. Odcinki te muszą istnieć. Przejmuje na własność listę @p list.
+ * @param[in,out] nationalRoute – wskaźnik na drogę krajową;
+ * @param[in] position – pozycja, na której znajdzie się pierwsze miasto listy;
+ * @param[in] list - wskaźnik na wstawianą listę.
+ * @return Wartość @p true, jeśli udało się wstawić listę.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci; wtedy droga
+ * krajowa nie jest zmieniana.
+ */
+bool insertRouteSections(NationalRoute *nationalRoute, int position,
+                         CitiesList *list);
+
+/** @brief Sprawdza, czy miasto o numerze @p id należy do drogi krajowej.
+ * Działa w oczekiwanym czasie stałym.
+ * @param[in] nationalRoute – wskaźnik na drogę krajową;
+ * @param[in] id – numer miasta.
+ * @return Wartość @p true, jeśli miasto należy do drogi krajowej.
+ * Wartość @p false wpp.
  */
-void addAfterRouteSection(CitiesListNode *node, CitiesList *list);
+bool isCityIdInRoute(NationalRoute *nationalRoute, int id);
 
 #endif  // __NATIONAL_ROUTE_H__
@@ -0,0 +1,140 @@
+#include "node_pool.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "cities_list.h"
+#include "defines.h"
+#include "roads_list.h"
+#include "routes_list.h"
+#include "trie.h"
+
+void initNodePool(NodePool *pool, size_t nodeSize) {
+  assert(pool);
+
+  size_t align = sizeof(max_align_t);
+  pool->nodeSize = (nodeSize + align - 1) / align * align;
+  pool->slabLength = INITIAL_SLAB_LENGTH;
+  pool->slabs = NULL;
+  pool->cursor = NULL;
+  pool->end = NULL;
+  pool->freeList = NULL;
+}
+
+void releaseNodePool(NodePool *pool) {
+  assert(pool);
+
+  while (pool->slabs != NULL) {
+    NodeSlab *next = pool->slabs->next;
+    free(pool->slabs);
+    pool->slabs = next;
+  }
+  initNodePool(pool, pool->nodeSize);
+}
+
+void *allocNode(NodePool *pool) {
+  assert(pool);
+
+  if (pool->freeList != NULL) {
+    void *node = pool->freeList;
+    pool->freeList = *(void **)node;
+    return node;
+  }
+
+  if (pool->cursor == pool->end) {
+    NodeSlab *slab = (NodeSlab *)malloc(sizeof(NodeSlab) +
+                                        pool->slabLength * pool->nodeSize);
+    if (slab == NULL) {
+      return NULL;
+    }
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->cursor = (char *)slab->data;
+    pool->end = pool->cursor + pool->slabLength * pool->nodeSize;
+    if (pool->slabLength < MAX_SLAB_LENGTH) {
+      pool->slabLength *= 2;
+    }
+  }
+
+  void *node = pool->cursor;
+  pool->cursor += pool->nodeSize;
+  return node;
+}
+
+char *allocBytes(NodePool *pool, size_t size) {
+  assert(pool);
+
+  if ((size_t)(pool->end - pool->cursor) < size) {
+    size_t slabSize = pool->slabLength * pool->nodeSize;
+    if (slabSize < size) {
+      slabSize = size;
+    }
+
+    NodeSlab *slab = (NodeSlab *)malloc(sizeof(NodeSlab) + slabSize);
+    if (slab == NULL) {
+      return NULL;
+    }
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->cursor = (char *)slab->data;
+    pool->end = pool->cursor + slabSize;
+    if (pool->slabLength < MAX_SLAB_LENGTH) {
+      pool->slabLength *= 2;
+    }
+  }
+
+  char *bytes = pool->cursor;
+  pool->cursor += size;
+  return bytes;
+}
+
+void freeNode(NodePool *pool, void *node) {
+  assert(pool);
+
+  if (node == NULL) {
+    return;
+  }
+  *(void **)node = pool->freeList;
+  pool->freeList = node;
+}
+
+NodePools *newNodePools() {
+  NodePools *pools = (NodePools *)malloc(sizeof(NodePools));
+  if (pools == NULL) {
+    return NULL;
+  }
+
+  initNodePool(&pools->trieNodes, sizeof(Trie));
+  initNodePool(&pools->trieIndexed, sizeof(TrieIndexedChildren));
+  initNodePool(&pools->trieTables, TRIE_TABLE_SIZE * sizeof(Trie *));
+  initNodePool(&pools->trieLabels, 1);
+  initNodePool(&pools->roadsLists, sizeof(RoadsList));
+  initNodePool(&pools->roadsNodes, sizeof(RoadsListNode));
+  initNodePool(&pools->roads, sizeof(Road));
+  initNodePool(&pools->routesLists, sizeof(RoutesList));
+  initNodePool(&pools->routesNodes, sizeof(RoutesListNode));
+  initNodePool(&pools->citiesLists, sizeof(CitiesList));
+  initNodePool(&pools->citiesNodes, sizeof(CitiesListNode));
+  return pools;
+}
+
+void deleteNodePools(NodePools *pools) {
+  if (pools == NULL) {
+    return;
+  }
+
+  releaseNodePool(&pools->trieNodes);
+  releaseNodePool(&pools->trieIndexed);
+  releaseNodePool(&pools->trieTables);
+  releaseNodePool(&pools->trieLabels);
+  releaseNodePool(&pools->roadsLists);
+  releaseNodePool(&pools->roadsNodes);
+  releaseNodePool(&pools->roads);
+  releaseNodePool(&pools->routesLists);
+  releaseNodePool(&pools->routesNodes);
+  releaseNodePool(&pools->citiesLists);
+  releaseNodePool(&pools->citiesNodes);
+  free(pools);
+}
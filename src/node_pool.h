@@ -0,0 +1,96 @@
+/** @file
+ * Interfejs pul pamięci, z których przydzielane są węzły list i drzewa Trie
+ */
+
+#ifndef __NODE_POOL_H__
+#define __NODE_POOL_H__
+
+#include <stddef.h>
+
+/**
+ * Blok pamięci, dzielony na węzły jednego rozmiaru.
+ */
+typedef struct NodeSlab {
+  struct NodeSlab *next;  ///< wskaźnik na poprzednio przydzielony blok
+  max_align_t data[];     ///< pamięć przeznaczona na węzły
+} NodeSlab;
+
+/**
+ * Pula węzłów jednego rozmiaru. Węzły są wydzielane z kolejnych, coraz
+ * większych bloków, a zwolnione węzły trafiają na listę wolnych węzłów
+ * i są przydzielane ponownie. Pamięć bloków jest zwalniana dopiero razem
+ * z całą pulą.
+ */
+typedef struct NodePool {
+  size_t nodeSize;  ///< rozmiar węzła, zaokrąglony w górę do wyrównania
+  int slabLength;   ///< liczba węzłów w następnym przydzielanym bloku
+  NodeSlab *slabs;  ///< lista przydzielonych bloków
+  char *cursor;     ///< początek niewykorzystanej części ostatniego bloku
+  char *end;        ///< koniec ostatniego bloku
+  void *freeList;   ///< lista zwolnionych węzłów
+} NodePool;
+
+/**
+ * Pule węzłów wszystkich struktur, z których składa się mapa.
+ */
+typedef struct NodePools {
+  NodePool trieNodes;      ///< węzły drzewa Trie
+  NodePool trieIndexed;    ///< indeksowane dzieci węzłów drzewa Trie
+  NodePool trieTables;     ///< tablice dzieci węzłów drzewa Trie
+  NodePool trieLabels;     ///< napisy na krawędziach drzewa Trie
+  NodePool roadsLists;     ///< listy odcinków dróg
+  NodePool roadsNodes;     ///< węzły list odcinków dróg
+  NodePool roads;          ///< odcinki dróg
+  NodePool routesLists;    ///< listy dróg krajowych
+  NodePool routesNodes;    ///< węzły list dróg krajowych
+  NodePool citiesLists;    ///< listy miast
+  NodePool citiesNodes;    ///< węzły list miast
+} NodePools;
+
+/** @brief Przygotowuje pustą pulę węzłów.
+ * @param[out] pool    – wskaźnik na pulę;
+ * @param[in] nodeSize – rozmiar węzła.
+ */
+void initNodePool(NodePool *pool, size_t nodeSize);
+
+/** @brief Zwalnia całą pamięć puli.
+ * Wszystkie przydzielone z puli węzły przestają być poprawne.
+ * @param[in,out] pool – wskaźnik na pulę.
+ */
+void releaseNodePool(NodePool *pool);
+
+/** @brief Przydziela węzeł z puli.
+ * @param[in,out] pool – wskaźnik na pulę.
+ * @return Wskaźnik na węzeł lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+void *allocNode(NodePool *pool);
+
+/** @brief Zwraca węzeł do puli.
+ * Nic nie robi, jeśli wskaźnik @p node ma wartość NULL.
+ * @param[in,out] pool – wskaźnik na pulę, z której przydzielono węzeł;
+ * @param[in] node     – wskaźnik na zwalniany węzeł.
+ */
+void freeNode(NodePool *pool, void *node);
+
+/** @brief Przydziela z puli spójny obszar @p size bajtów.
+ * Obszar nie jest wyrównany i nie może zostać zwrócony do puli; jest
+ * zwalniany razem z nią. Pula musi służyć wyłącznie do takich przydziałów.
+ * @param[in,out] pool – wskaźnik na pulę;
+ * @param[in] size     – liczba bajtów.
+ * @return Wskaźnik na obszar lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+char *allocBytes(NodePool *pool, size_t size);
+
+/** @brief Tworzy pule węzłów wszystkich struktur mapy.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci.
+ */
+NodePools *newNodePools();
+
+/** @brief Usuwa pule węzłów razem ze wszystkimi przydzielonymi z nich węzłami.
+ * Nic nie robi, jeśli wskaźnik @p pools ma wartość NULL.
+ * @param[in] pools – wskaźnik na usuwaną strukturę.
+ */
+void deleteNodePools(NodePools *pools);
+
+#endif  // __NODE_POOL_H__
@@ -0,0 +1,102 @@
+// write jest częścią POSIX, a nie standardu C11
+#define _POSIX_C_SOURCE 200809L
+
+#include "output_writer.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "defines.h"
+
+OutputWriter *newOutputWriter(int fd) {
+  OutputWriter *writer = (OutputWriter *)malloc(sizeof(OutputWriter));
+  if (writer == NULL) {
+    return NULL;
+  }
+
+  writer->buffer = (char *)malloc(OUTPUT_BUFFER_SIZE * sizeof(char));
+  if (writer->buffer == NULL) {
+    free(writer);
+    return NULL;
+  }
+
+  writer->fd = fd;
+  writer->capacity = OUTPUT_BUFFER_SIZE;
+  writer->length = 0;
+  writer->hasFailed = false;
+  return writer;
+}
+
+void deleteOutputWriter(OutputWriter *writer) {
+  if (writer == NULL) {
+    return;
+  }
+  flushOutput(writer);
+  free(writer->buffer);
+  free(writer);
+}
+
+// Zapisuje do deskryptora całą tablicę @p chars, ponawiając przerwane
+// i częściowe zapisy.
+static bool writeAll(OutputWriter *writer, const char *chars, size_t length) {
+  while (length > 0 && !writer->hasFailed) {
+    ssize_t count = write(writer->fd, chars, length);
+    if (count < 0) {
+      writer->hasFailed = errno != EINTR;
+      continue;
+    }
+    chars += count;
+    length -= (size_t)count;
+  }
+  return !writer->hasFailed;
+}
+
+bool flushOutput(OutputWriter *writer) {
+  assert(writer);
+
+  bool isWritten = writeAll(writer, writer->buffer, writer->length);
+  writer->length = 0;
+  return isWritten;
+}
+
+bool writeOutput(OutputWriter *writer, const char *chars, size_t length) {
+  assert(writer);
+
+  if (writer->hasFailed) {
+    return false;
+  }
+  if (length > writer->capacity - writer->length) {
+    if (!flushOutput(writer)) {
+      return false;
+    }
+    if (length >= writer->capacity) {
+      return writeAll(writer, chars, length);
+    }
+  }
+
+  memcpy(writer->buffer + writer->length, chars, length);
+  writer->length += length;
+  return true;
+}
+
+bool writeLineError(OutputWriter *writer, int lineNumber) {
+  assert(lineNumber > 0);
+
+  // cyfry numeru wiersza wpisuję od końca
+  char message[sizeof("ERROR \n") + MAX_NUMBER_LENGTH];
+  char *end = message + sizeof(message);
+  char *begin = end - 1;
+  *begin = '\n';
+  do {
+    *--begin = (char)('0' + lineNumber % 10);
+    lineNumber /= 10;
+  } while (lineNumber > 0);
+  begin -= strlen("ERROR ");
+  memcpy(begin, "ERROR ", strlen("ERROR "));
+
+  return writeOutput(writer, begin, (size_t)(end - begin));
+}
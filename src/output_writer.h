@@ -0,0 +1,65 @@
+/** @file
+ * Interfejs buforowanego zapisu odpowiedzi na polecenia
+ */
+
+#ifndef __OUTPUT_WRITER_H__
+#define __OUTPUT_WRITER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Bufor wyjścia. Zapisywane znaki są gromadzone w buforze i przekazywane do
+ * deskryptora dopiero po jego zapełnieniu lub przy jawnym opróżnieniu. Po
+ * pierwszym nieudanym zapisie bufor pamięta błąd i odrzuca kolejne znaki.
+ */
+typedef struct OutputWriter {
+  int fd;           ///< deskryptor, do którego zapisywane są dane
+  char *buffer;     ///< bufor na niezapisane znaki
+  size_t capacity;  ///< rozmiar bufora
+  size_t length;    ///< liczba znaków w buforze
+  bool hasFailed;   ///< informacja, czy któryś zapis się nie powiódł
+} OutputWriter;
+
+/** @brief Tworzy bufor zapisujący do deskryptora @p fd.
+ * @param[in] fd – deskryptor otwarty do pisania.
+ * @return Wskaźnik na bufor lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+OutputWriter *newOutputWriter(int fd);
+
+/** @brief Usuwa bufor.
+ * Przed usunięciem zapisuje do deskryptora pozostałe w nim znaki. Nic nie
+ * robi, jeśli wskaźnik @p writer ma wartość NULL.
+ * @param[in] writer – wskaźnik na usuwany bufor.
+ */
+void deleteOutputWriter(OutputWriter *writer);
+
+/** @brief Zapisuje do deskryptora wszystkie znaki z bufora.
+ * @param[in,out] writer – wskaźnik na bufor.
+ * @return Wartość @p true, jeśli udało się zapisać znaki.
+ * Wartość @p false, jeśli zapis się nie powiódł, teraz lub wcześniej.
+ */
+bool flushOutput(OutputWriter *writer);
+
+/** @brief Dopisuje znaki do bufora.
+ * Jeśli się w nim nie mieszczą, najpierw go opróżnia, a fragment dłuższy
+ * niż cały bufor zapisuje bezpośrednio do deskryptora.
+ * @param[in,out] writer – wskaźnik na bufor;
+ * @param[in] chars      – wskaźnik na zapisywane znaki;
+ * @param[in] length     – liczba znaków.
+ * @return Wartość @p true, jeśli udało się zapisać znaki.
+ * Wartość @p false, jeśli zapis się nie powiódł, teraz lub wcześniej.
+ */
+bool writeOutput(OutputWriter *writer, const char *chars, size_t length);
+
+/** @brief Dopisuje do bufora komunikat o błędzie w wierszu.
+ * Komunikat ma postać "ERROR n" zakończoną znakiem '\n', gdzie n jest
+ * numerem wiersza.
+ * @param[in,out] writer  – wskaźnik na bufor;
+ * @param[in] lineNumber  – dodatni numer wiersza.
+ * @return Wartość @p true, jeśli udało się zapisać komunikat.
+ * Wartość @p false, jeśli zapis się nie powiódł, teraz lub wcześniej.
+ */
+bool writeLineError(OutputWriter *writer, int lineNumber);
+
+#endif  // __OUTPUT_WRITER_H__
@@ -0,0 +1,212 @@
+#include "roads_graph.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "defines.h"
+
+RoadsGraph *newRoadsGraph() {
+  RoadsGraph *graph = (RoadsGraph *)malloc(sizeof(RoadsGraph));
+  if (graph == NULL) {
+    return NULL;
+  }
+
+  graph->rows = NULL;
+  graph->numOfRows = 0;
+  graph->rowsCapacity = 0;
+  graph->edges = NULL;
+  graph->slots = NULL;
+  graph->numOfEdges = 0;
+  graph->edgesCapacity = 0;
+  graph->numOfWasted = 0;
+  return graph;
+}
+
+void deleteRoadsGraph(RoadsGraph *graph) {
+  if (graph == NULL) {
+    return;
+  }
+  free(graph->rows);
+  free(graph->edges);
+  free(graph->slots);
+  free(graph);
+}
+
+bool reserveGraphCities(RoadsGraph *graph, int numOfCities) {
+  assert(graph);
+
+  if (graph->rowsCapacity < numOfCities) {
+    int capacity =
+        graph->rowsCapacity > 0 ? graph->rowsCapacity : INITIAL_GRAPH_CAPACITY;
+    while (capacity < numOfCities) {
+      capacity *= 2;
+    }
+
+    GraphRow *rows =
+        (GraphRow *)realloc(graph->rows, capacity * sizeof(GraphRow));
+    if (rows == NULL) {
+      return false;
+    }
+    graph->rows = rows;
+    graph->rowsCapacity = capacity;
+  }
+
+  while (graph->numOfRows < numOfCities) {
+    GraphRow *row = &graph->rows[graph->numOfRows++];
+    row->begin = 0;
+    row->degree = 0;
+    row->capacity = 0;
+  }
+  return true;
+}
+
+// Przepisuje odcinki do nowej tablicy, pomijając miejsca zwolnione przy
+// przenoszeniu fragmentów.
+static bool compactRoadsGraph(RoadsGraph *graph) {
+  int capacity = INITIAL_GRAPH_CAPACITY;
+  while (capacity < 2 * (graph->numOfEdges - graph->numOfWasted)) {
+    capacity *= 2;
+  }
+
+  GraphEdge *edges = (GraphEdge *)malloc(capacity * sizeof(GraphEdge));
+  int **slots = (int **)malloc(capacity * sizeof(int *));
+  if (edges == NULL || slots == NULL) {
+    free(edges);
+    free(slots);
+    return false;
+  }
+
+  int pos = 0;
+  for (int i = 0; i < graph->numOfRows; i++) {
+    GraphRow *row = &graph->rows[i];
+    memcpy(edges + pos, graph->edges + row->begin,
+           row->degree * sizeof(GraphEdge));
+    memcpy(slots + pos, graph->slots + row->begin,
+           row->degree * sizeof(int *));
+    row->begin = pos;
+    for (int j = pos; j < pos + row->degree; j++) {
+      *slots[j] = j;
+    }
+    pos += row->capacity;
+  }
+
+  free(graph->edges);
+  free(graph->slots);
+  graph->edges = edges;
+  graph->slots = slots;
+  graph->numOfEdges = pos;
+  graph->edgesCapacity = capacity;
+  graph->numOfWasted = 0;
+  return true;
+}
+
+// Zapewnia, że w tablicy odcinków jest co najmniej @p extra wolnych miejsc.
+static bool reserveGraphEdges(RoadsGraph *graph, int extra) {
+  if (graph->numOfEdges + extra <= graph->edgesCapacity) {
+    return true;
+  }
+
+  int capacity = graph->edgesCapacity > 0 ? graph->edgesCapacity
+                                          : INITIAL_GRAPH_CAPACITY;
+  while (capacity < graph->numOfEdges + extra) {
+    capacity *= 2;
+  }
+
+  GraphEdge *edges =
+      (GraphEdge *)realloc(graph->edges, capacity * sizeof(GraphEdge));
+  if (edges == NULL) {
+    return false;
+  }
+  graph->edges = edges;
+
+  int **slots = (int **)realloc(graph->slots, capacity * sizeof(int *));
+  if (slots == NULL) {
+    return false;
+  }
+  graph->slots = slots;
+  graph->edgesCapacity = capacity;
+  return true;
+}
+
+// Zwiększa dwukrotnie liczbę miejsc zarezerwowanych dla miasta @p id.
+static bool growGraphRow(RoadsGraph *graph, int id) {
+  GraphRow *row = &graph->rows[id];
+  int capacity = row->capacity > 0 ? 2 * row->capacity : 1;
+
+  if (row->begin + row->capacity == graph->numOfEdges) {
+    // fragment leży na końcu tablicy, więc wystarczy go wydłużyć
+    if (!reserveGraphEdges(graph, capacity - row->capacity)) {
+      return false;
+    }
+    graph->numOfEdges += capacity - row->capacity;
+    row->capacity = capacity;
+    return true;
+  }
+
+  if (!reserveGraphEdges(graph, capacity)) {
+    return false;
+  }
+
+  memcpy(graph->edges + graph->numOfEdges, graph->edges + row->begin,
+         row->degree * sizeof(GraphEdge));
+  memcpy(graph->slots + graph->numOfEdges, graph->slots + row->begin,
+         row->degree * sizeof(int *));
+  for (int i = 0; i < row->degree; i++) {
+    *graph->slots[graph->numOfEdges + i] = graph->numOfEdges + i;
+  }
+  graph->numOfWasted += row->capacity;
+  row->begin = graph->numOfEdges;
+  row->capacity = capacity;
+  graph->numOfEdges += capacity;
+
+  if (graph->numOfWasted > graph->numOfEdges / 2) {
+    // nieudane zagęszczenie nie psuje grafu, jedynie zajmuje więcej pamięci
+    compactRoadsGraph(graph);
+  }
+  return true;
+}
+
+bool addGraphEdge(RoadsGraph *graph, int from, int to, unsigned length,
+                  int builtYear, int *slot) {
+  assert(graph);
+  assert(0 <= from && from < graph->numOfRows);
+  assert(0 <= to && to < graph->numOfRows);
+
+  if (graph->rows[from].degree == graph->rows[from].capacity) {
+    if (!growGraphRow(graph, from)) {
+      return false;
+    }
+  }
+
+  GraphRow *row = &graph->rows[from];
+  int pos = row->begin + row->degree++;
+  GraphEdge *edge = &graph->edges[pos];
+  edge->neighbour = to;
+  edge->length = length;
+  edge->builtYear = builtYear;
+  graph->slots[pos] = slot;
+  *slot = pos;
+  return true;
+}
+
+void removeGraphEdge(RoadsGraph *graph, int from, int edge) {
+  assert(graph);
+
+  GraphRow *row = &graph->rows[from];
+  assert(row->begin <= edge && edge < row->begin + row->degree);
+
+  int last = row->begin + row->degree - 1;
+  graph->edges[edge] = graph->edges[last];
+  graph->slots[edge] = graph->slots[last];
+  *graph->slots[edge] = edge;
+  row->degree--;
+}
+
+void repairGraphEdge(RoadsGraph *graph, int edge, int repairYear) {
+  assert(graph);
+  assert(0 <= edge && edge < graph->numOfEdges);
+
+  graph->edges[edge].builtYear = repairYear;
+}
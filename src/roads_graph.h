@@ -0,0 +1,99 @@
+/** @file
+ * Interfejs zwartej reprezentacji grafu odcinków dróg, wykorzystywanej przez
+ * algorytm wyszukiwania najkrótszych dróg
+ */
+
+#ifndef __ROADS_GRAPH_H__
+#define __ROADS_GRAPH_H__
+
+#include <stdbool.h>
+
+/**
+ * Odcinek drogi wychodzący z miasta.
+ */
+typedef struct GraphEdge {
+  int neighbour;    ///< numer sąsiedniego miasta
+  unsigned length;  ///< długość odcinka drogi
+  int builtYear;    ///< rok budowy lub ostatniego remontu odcinka drogi
+} GraphEdge;
+
+/**
+ * Fragment tablicy odcinków, przechowujący odcinki wychodzące z jednego miasta.
+ */
+typedef struct GraphRow {
+  int begin;     ///< indeks pierwszego odcinka w tablicy odcinków
+  int degree;    ///< liczba odcinków wychodzących z miasta
+  int capacity;  ///< liczba miejsc zarezerwowanych dla miasta
+} GraphRow;
+
+/**
+ * Graf odcinków dróg w postaci tablic sąsiedztwa (CSR). Odcinki wychodzące
+ * z jednego miasta zajmują spójny fragment tablicy @p edges. Fragment, który
+ * się zapełni, jest przenoszony na koniec tablicy z dwukrotnie większą liczbą
+ * miejsc, a gdy nieużywane miejsca zajmą połowę tablicy, graf jest zagęszczany.
+ * Przy każdym przeniesieniu odcinka jego nowy indeks jest wpisywany w miejsce
+ * wskazane przy dodawaniu, więc odcinek można zmienić bez wyszukiwania go.
+ */
+typedef struct RoadsGraph {
+  GraphRow *rows;      ///< tablica fragmentów, indeksowana numerami miast
+  int numOfRows;       ///< liczba miast w grafie
+  int rowsCapacity;    ///< rozmiar tablicy @p rows
+  GraphEdge *edges;    ///< tablica odcinków
+  int **slots;         ///< miejsca, w których zapisane są indeksy odcinków
+  int numOfEdges;      ///< liczba zajętych miejsc w tablicy @p edges
+  int edgesCapacity;   ///< rozmiar tablic @p edges i @p slots
+  int numOfWasted;     ///< liczba miejsc zwolnionych przy przenoszeniu
+} RoadsGraph;
+
+/** @brief Tworzy nową strukturę.
+ * Tworzy nowy, pusty graf.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci.
+ */
+RoadsGraph *newRoadsGraph();
+
+/** @brief Usuwa strukturę.
+ * Nic nie robi, jeśli wskaźnik @p graph ma wartość NULL.
+ * @param[in] graph – wskaźnik na usuwaną strukturę.
+ */
+void deleteRoadsGraph(RoadsGraph *graph);
+
+/** @brief Dodaje do grafu miasta o numerach mniejszych niż @p numOfCities.
+ * @param[in,out] graph  – wskaźnik na graf;
+ * @param[in] numOfCities – liczba miast w mapie.
+ * @return Wartość @p true, jeśli się udało.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+bool reserveGraphCities(RoadsGraph *graph, int numOfCities);
+
+/** @brief Dodaje odcinek drogi z miasta @p from do miasta @p to.
+ * Indeks odcinka jest zapisywany w miejscu @p slot i uaktualniany przy
+ * każdym przeniesieniu odcinka, dopóki nie zostanie on usunięty.
+ * @param[in,out] graph  – wskaźnik na graf;
+ * @param[in] from       – numer miasta, z którego wychodzi odcinek;
+ * @param[in] to         – numer miasta, do którego prowadzi odcinek;
+ * @param[in] length     – długość odcinka drogi;
+ * @param[in] builtYear  – rok budowy odcinka drogi;
+ * @param[out] slot      – wskaźnik na miejsce na indeks odcinka.
+ * @return Wartość @p true, jeśli się udało.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+bool addGraphEdge(RoadsGraph *graph, int from, int to, unsigned length,
+                  int builtYear, int *slot);
+
+/** @brief Usuwa odcinek drogi o indeksie @p edge wychodzący z miasta @p from.
+ * Na jego miejsce przenosi ostatni odcinek miasta.
+ * @param[in,out] graph  – wskaźnik na graf;
+ * @param[in] from       – numer miasta, z którego wychodzi odcinek;
+ * @param[in] edge       – indeks odcinka.
+ */
+void removeGraphEdge(RoadsGraph *graph, int from, int edge);
+
+/** @brief Zmienia rok remontu odcinka drogi o indeksie @p edge.
+ * @param[in,out] graph   – wskaźnik na graf;
+ * @param[in] edge        – indeks odcinka;
+ * @param[in] repairYear  – rok remontu odcinka drogi.
+ */
+void repairGraphEdge(RoadsGraph *graph, int edge, int repairYear);
+
+#endif  // __ROADS_GRAPH_H__
@@ -0,0 +1,133 @@
+#include "roads_index.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "defines.h"
+
+// Tworzy tablicę elementów o rozmiarze @p capacity, wypełnioną pustymi
+// elementami.
+static RoadsIndexEntry *newRoadsIndexEntries(int capacity) {
+  RoadsIndexEntry *entries =
+      (RoadsIndexEntry *)malloc(capacity * sizeof(RoadsIndexEntry));
+  if (entries == NULL) {
+    return NULL;
+  }
+  for (int i = 0; i < capacity; i++) {
+    entries[i].neighbour = -1;
+    entries[i].road = NULL;
+  }
+  return entries;
+}
+
+static int hashNeighbour(int neighbour, int capacity) {
+  return (int)(((unsigned)neighbour * 2654435761U) & (unsigned)(capacity - 1));
+}
+
+RoadsIndex *newRoadsIndex() {
+  RoadsIndex *index = (RoadsIndex *)malloc(sizeof(RoadsIndex));
+  if (index == NULL) {
+    return NULL;
+  }
+
+  index->entries = newRoadsIndexEntries(INITIAL_ROADS_INDEX_CAPACITY);
+  if (index->entries == NULL) {
+    free(index);
+    return NULL;
+  }
+
+  index->size = 0;
+  index->capacity = INITIAL_ROADS_INDEX_CAPACITY;
+  return index;
+}
+
+void deleteRoadsIndex(RoadsIndex *index) {
+  if (index == NULL) {
+    return;
+  }
+  free(index->entries);
+  free(index);
+}
+
+RoadsListNode *findInRoadsIndex(RoadsIndex *index, int neighbour) {
+  assert(index);
+
+  int pos = hashNeighbour(neighbour, index->capacity);
+  while (index->entries[pos].neighbour != -1) {
+    if (index->entries[pos].neighbour == neighbour) {
+      return index->entries[pos].road;
+    }
+    pos = (pos + 1) & (index->capacity - 1);
+  }
+  return NULL;
+}
+
+// Wstawia element, zakładając, że w tablicy jest wolne miejsce.
+static void placeInRoadsIndex(RoadsIndexEntry *entries, int capacity,
+                              int neighbour, RoadsListNode *road) {
+  int pos = hashNeighbour(neighbour, capacity);
+  while (entries[pos].neighbour != -1) {
+    pos = (pos + 1) & (capacity - 1);
+  }
+  entries[pos].neighbour = neighbour;
+  entries[pos].road = road;
+}
+
+bool insertIntoRoadsIndex(RoadsIndex *index, int neighbour,
+                          RoadsListNode *road) {
+  assert(index);
+  assert(findInRoadsIndex(index, neighbour) == NULL);
+
+  // współczynnik wypełnienia nie przekracza 1/2
+  if (2 * (index->size + 1) > index->capacity) {
+    int capacity = 2 * index->capacity;
+    RoadsIndexEntry *entries = newRoadsIndexEntries(capacity);
+    if (entries == NULL) {
+      return false;
+    }
+    for (int i = 0; i < index->capacity; i++) {
+      if (index->entries[i].neighbour != -1) {
+        placeInRoadsIndex(entries, capacity, index->entries[i].neighbour,
+                          index->entries[i].road);
+      }
+    }
+    free(index->entries);
+    index->entries = entries;
+    index->capacity = capacity;
+  }
+
+  placeInRoadsIndex(index->entries, index->capacity, neighbour, road);
+  index->size++;
+  return true;
+}
+
+void removeFromRoadsIndex(RoadsIndex *index, int neighbour) {
+  assert(index);
+
+  int mask = index->capacity - 1;
+  int pos = hashNeighbour(neighbour, index->capacity);
+  while (index->entries[pos].neighbour != neighbour) {
+    if (index->entries[pos].neighbour == -1) {
+      return;
+    }
+    pos = (pos + 1) & mask;
+  }
+
+  // Przesuwa wstecz kolejne elementy ciągu, aby nie zostawiać w nim dziury,
+  // która przerwałaby późniejsze wyszukiwania.
+  int hole = pos;
+  int next = (pos + 1) & mask;
+  while (index->entries[next].neighbour != -1) {
+    int home = hashNeighbour(index->entries[next].neighbour, index->capacity);
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      index->entries[hole] = index->entries[next];
+      hole = next;
+    }
+    next = (next + 1) & mask;
+  }
+
+  index->entries[hole].neighbour = -1;
+  index->entries[hole].road = NULL;
+  index->size--;
+}
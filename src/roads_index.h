@@ -0,0 +1,67 @@
+/** @file
+ * Interfejs tablicy haszującej, indeksującej odcinki dróg wychodzące z miasta
+ * numerami sąsiednich miast
+ */
+
+#ifndef __ROADS_INDEX_H__
+#define __ROADS_INDEX_H__
+
+#include <stdbool.h>
+
+#include "roads_list.h"
+
+/**
+ * Element tablicy haszującej.
+ */
+typedef struct RoadsIndexEntry {
+  int neighbour;        ///< numer sąsiedniego miasta lub -1, gdy puste
+  RoadsListNode *road;  ///< wskaźnik na odcinek drogi do sąsiada
+} RoadsIndexEntry;
+
+/**
+ * Tablica haszująca z adresowaniem otwartym (próbkowanie liniowe).
+ */
+typedef struct RoadsIndex {
+  RoadsIndexEntry *entries;  ///< tablica elementów
+  int size;                  ///< liczba zajętych elementów
+  int capacity;              ///< rozmiar tablicy, zawsze potęga dwójki
+} RoadsIndex;
+
+/** @brief Tworzy nową, pustą tablicę.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci.
+ */
+RoadsIndex *newRoadsIndex();
+
+/** @brief Usuwa tablicę.
+ * Nic nie robi, jeśli wskaźnik @p index ma wartość NULL.
+ * @param[in] index – wskaźnik na usuwaną strukturę.
+ */
+void deleteRoadsIndex(RoadsIndex *index);
+
+/** @brief Wyszukuje odcinek drogi do miasta o numerze @p neighbour.
+ * @param[in] index     – wskaźnik na tablicę;
+ * @param[in] neighbour – numer sąsiedniego miasta.
+ * @return Wskaźnik na odcinek drogi lub NULL, jeśli go nie ma.
+ */
+RoadsListNode *findInRoadsIndex(RoadsIndex *index, int neighbour);
+
+/** @brief Dodaje odcinek drogi do tablicy.
+ * W tablicy nie może być odcinka do tego samego miasta.
+ * @param[in,out] index – wskaźnik na tablicę;
+ * @param[in] neighbour – numer sąsiedniego miasta;
+ * @param[in] road      – wskaźnik na odcinek drogi.
+ * @return Wartość @p true, jeśli się udało.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+bool insertIntoRoadsIndex(RoadsIndex *index, int neighbour,
+                          RoadsListNode *road);
+
+/** @brief Usuwa z tablicy odcinek drogi do miasta o numerze @p neighbour.
+ * Nic nie robi, jeśli takiego odcinka nie ma.
+ * @param[in,out] index – wskaźnik na tablicę;
+ * @param[in] neighbour – numer sąsiedniego miasta.
+ */
+void removeFromRoadsIndex(RoadsIndex *index, int neighbour);
+
+#endif  // __ROADS_INDEX_H__
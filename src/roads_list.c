@@ -5,18 +5,43 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-RoadsListElement newRoadsListElem(void *city, unsigned length, int builtYear) {
+Road *newRoad(NodePools *pools, unsigned length, int builtYear) {
+  Road *road = (Road *)allocNode(&pools->roads);
+  if (road == NULL) {
+    return NULL;
+  }
+
+  road->routes = newRoutesList(pools);
+  if (road->routes == NULL) {
+    freeNode(&pools->roads, road);
+    return NULL;
+  }
+
+  road->length = length;
+  road->builtYear = builtYear;
+  road->refCount = 0;
+  return road;
+}
+
+void deleteRoad(Road *road) {
+  if (road == NULL) {
+    return;
+  }
+  NodePools *pools = road->routes->pools;
+  deleteRoutesList(road->routes);
+  freeNode(&pools->roads, road);
+}
+
+RoadsListElement newRoadsListElem(void *city, Road *road) {
   RoadsListElement elem;
   elem.city = city;
-  elem.length = length;
-  elem.builtYear = builtYear;
-  elem.routes = NULL;
+  elem.road = road;
   return elem;
 }
 
-RoadsListNode *newRoadsListNode(RoadsListNode *prev, RoadsListElement elem,
-                                RoadsListNode *next) {
-  RoadsListNode *node = (RoadsListNode *)malloc(sizeof(RoadsListNode));
+RoadsListNode *newRoadsListNode(NodePools *pools, RoadsListNode *prev,
+                                RoadsListElement elem, RoadsListNode *next) {
+  RoadsListNode *node = (RoadsListNode *)allocNode(&pools->roadsNodes);
   if (node == NULL) {
     return NULL;
   }
@@ -27,27 +52,23 @@ RoadsListNode *newRoadsListNode(RoadsListNode *prev, RoadsListElement elem,
   return node;
 }
 
-RoadsList *newRoadsList() {
-  RoadsList *list = (RoadsList *)malloc(sizeof(RoadsList));
+RoadsList *newRoadsList(NodePools *pools) {
+  RoadsList *list = (RoadsList *)allocNode(&pools->roadsLists);
   if (list == NULL) {
     return NULL;
   }
 
-  list->head = newRoadsListNode(NULL, newRoadsListElem(NULL, 0, 0), NULL);
-  if (list->head == NULL) {
-    free(list);
-    list = NULL;
-    return NULL;
-  }
-
-  list->tail = newRoadsListNode(list->head, newRoadsListElem(NULL, 0, 0), NULL);
-  if (list->tail == NULL) {
-    free(list);
-    list = NULL;
-    return NULL;
-  }
+  list->pools = pools;
+  list->head = &list->sentinels[0];
+  list->tail = &list->sentinels[1];
 
+  list->head->prev = NULL;
+  list->head->elem = newRoadsListElem(NULL, NULL);
   list->head->next = list->tail;
+
+  list->tail->prev = list->head;
+  list->tail->elem = newRoadsListElem(NULL, NULL);
+  list->tail->next = NULL;
   return list;
 }
 
@@ -55,18 +76,20 @@ bool isValidRoadsListNode(RoadsListNode *node) {
   return node != NULL && node->next != NULL && node->prev != NULL;
 }
 
-void removeRoadsListNode(RoadsListNode *node) {
+void removeRoadsListNode(RoadsList *list, RoadsListNode *node) {
+  assert(list != NULL);
   assert(node != NULL);
   assert(node->next != NULL);
   assert(node->prev != NULL);
-  assert(node->elem.routes);
+  assert(node->elem.road);
 
   node->next->prev = node->prev;
   node->prev->next = node->next;
 
-  deleteRoutesList(node->elem.routes);
-  free(node);
-  node = NULL;
+  if (--node->elem.road->refCount == 0) {
+    deleteRoad(node->elem.road);
+  }
+  freeNode(&list->pools->roadsNodes, node);
 }
 
 void popBackRoadsList(RoadsList *list) {
@@ -74,7 +97,7 @@ void popBackRoadsList(RoadsList *list) {
   assert(list->tail != NULL);
 
   if (isValidRoadsListNode(list->tail->prev)) {
-    removeRoadsListNode(list->tail->prev);
+    removeRoadsListNode(list, list->tail->prev);
   }
 }
 
@@ -85,27 +108,18 @@ void deleteRoadsList(RoadsList *list) {
   while (isValidRoadsListNode(list->tail->prev)) {
     popBackRoadsList(list);
   }
-  free(list->head);
-  free(list->tail);
-  free(list);
-  list = NULL;
+  freeNode(&list->pools->roadsLists, list);
 }
 
-bool addRoadsListNode(RoadsList *list, void *city, unsigned length,
-                      int builtYear) {
-  RoadsListNode *node = newRoadsListNode(
-      list->tail->prev, newRoadsListElem(city, length, builtYear), list->tail);
+bool addRoadsListNode(RoadsList *list, void *city, Road *road) {
+  RoadsListNode *node =
+      newRoadsListNode(list->pools, list->tail->prev,
+                       newRoadsListElem(city, road), list->tail);
   if (node == NULL) {
     return false;
   }
 
-  node->elem.routes = newRoutesList();
-  if (node->elem.routes == NULL) {
-    free(node);
-    node = NULL;
-    return false;
-  }
-
+  road->refCount++;
   list->tail->prev->next = node;
   list->tail->prev = node;
   return true;
@@ -5,16 +5,28 @@
 #ifndef __ROADS_LIST_H__
 #define __ROADS_LIST_H__
 
+#include "node_pool.h"
 #include "routes_list.h"
 
 /**
- * Element węzła listy dróg.
+ * Odcinek drogi, wspólny dla obu miast, które łączy. Element @p edges[0]
+ * tablicy to indeks w grafie odcinka wychodzącego z miasta o mniejszym
+ * numerze, a @p edges[1] z miasta o większym numerze.
  */
-typedef struct RoadsListElement {
-  void *city;          ///< wskaźnik na odpowiadający miastu węzeł w drzewie
+typedef struct Road {
   unsigned length;     ///< długość odcinka drogi
-  int builtYear;       ///< rok budowy odcinka drogi
+  int builtYear;       ///< rok budowy lub ostatniego remontu odcinka drogi
   RoutesList *routes;  ///< lista dróg krajowych, w których jest dany odcinek
+  int refCount;        ///< liczba węzłów list dróg, które wskazują na odcinek
+  int edges[2];        ///< indeksy obu kierunków odcinka w grafie
+} Road;
+
+/**
+ * Element węzła listy dróg.
+ */
+typedef struct RoadsListElement {
+  void *city;  ///< wskaźnik na odpowiadający sąsiedniemu miastu węzeł w drzewie
+  Road *road;  ///< wskaźnik na odcinek drogi do sąsiedniego miasta
 } RoadsListElement;
 
 /**
@@ -29,34 +41,54 @@ typedef struct RoadsListNode {
 
 /**
  * Lista dróg, reprezentowana przez głowę i ogon.
+ * Głowa i ogon są przechowywane w samej strukturze listy.
  */
 typedef struct RoadsList {
-  RoadsListNode *head;  ///< wskaźnik na głowę listy
-  RoadsListNode *tail;  ///< wskaźnik na ogon listy
+  RoadsListNode *head;         ///< wskaźnik na głowę listy
+  RoadsListNode *tail;         ///< wskaźnik na ogon listy
+  RoadsListNode sentinels[2];  ///< wartownicy: głowa i ogon
+  NodePools *pools;            ///< pule listy i jej węzłów
 } RoadsList;
 
-/** @brief Tworzy nowy element węzła listy.
- * @param[in] city      – wskaźnik na odpowiadający miastu węzeł;
+/** @brief Tworzy nowy odcinek drogi.
+ * Odcinek nie jest jeszcze wskazywany przez żaden węzeł listy dróg.
+ * @param[in] pools     – wskaźnik na pule węzłów;
  * @param[in] length    – długość odcinka drogi;
  * @param[in] builtYear – rok budowy odcinka drogi.
+ * @return Wskaźnik na odcinek lub NULL, gdy nie udało się zaalokować pamięci.
+ */
+Road *newRoad(NodePools *pools, unsigned length, int builtYear);
+
+/** @brief Usuwa odcinek drogi.
+ * Nic nie robi, jeśli wskaźnik @p road ma wartość NULL.
+ * @param[in] road – wskaźnik na usuwany odcinek.
+ */
+void deleteRoad(Road *road);
+
+/** @brief Tworzy nowy element węzła listy.
+ * @param[in] city – wskaźnik na odpowiadający miastu węzeł;
+ * @param[in] road – wskaźnik na odcinek drogi.
  * @return Element węzła.
  */
-RoadsListElement newRoadsListElem(void *city, unsigned length, int builtYear);
+RoadsListElement newRoadsListElem(void *city, Road *road);
 
 /** @brief Tworzy nowy węzeł listy.
  * Tworzy nowy węzeł, którego sąsiadami są prev i next.
+ * @param[in] pools – wskaźnik na pule węzłów;
  * @param[in] prev  – wskaźnik na poprzedni element w liście
  * @param[in] elem  – element węzła;
  * @param[in] next  – wskaźnik na następny element w liście.
  * @return Wskaźnik na węzeł.
  */
-RoadsListNode *newRoadsListNode(RoadsListNode *prev, RoadsListElement elem,
-                                RoadsListNode *next);
+RoadsListNode *newRoadsListNode(NodePools *pools, RoadsListNode *prev,
+                                RoadsListElement elem, RoadsListNode *next);
 
 /** @brief Tworzy nową listę.
- * @return Wskaźnik na listę.
+ * Lista i jej węzły są przydzielane z pul @p pools.
+ * @param[in] pools – wskaźnik na pule węzłów.
+ * @return Wskaźnik na listę lub NULL, gdy nie udało się zaalokować pamięci.
  */
-RoadsList *newRoadsList();
+RoadsList *newRoadsList(NodePools *pools);
 
 /** @brief Sprawdza, czy dany wierzchołek jest poprawnym wierzchołkiem listy.
  * @param[in] node - wskaźnik na dany wierzchołek
@@ -66,11 +98,12 @@ RoadsList *newRoadsList();
 bool isValidRoadsListNode(RoadsListNode *node);
 
 /** @brief Usuwa węzeł listy.
- * Usuwa węzeł wskazywany przez @p node.
- * Nic nie robi, jeśli wskaźnik ten ma wartość NULL.
- * @param[in] node – wskaźnik na usuwany wierzchołek.
+ * Usuwa węzeł wskazywany przez @p node i zwraca go do puli listy. Usuwa
+ * również odcinek drogi, jeśli nie wskazuje na niego już żaden inny węzeł.
+ * @param[in,out] list – wskaźnik na listę, do której należy węzeł;
+ * @param[in] node     – wskaźnik na usuwany wierzchołek.
  */
-void removeRoadsListNode(RoadsListNode *node);
+void removeRoadsListNode(RoadsList *list, RoadsListNode *node);
 
 /** @brief Usuwa ostatni węzeł listy.
  * Usuwa ostatni węzeł listy wskazywanej przez @p list.
@@ -89,12 +122,10 @@ void deleteRoadsList(RoadsList *list);
 /** @brief Tworzy i dodaje wierzchołek do listy.
  * @param[in] list  – wskaźnik na listę.
  * @param[in] city  – wskaźnik na odpowiadający miastu węzeł;
- * @param[in] length  – długość odcinka drogi;
- * @param[in] builtYear  – rok budowy odcinka drogi.
+ * @param[in] road  – wskaźnik na odcinek drogi.
  * @return Wartość @p true, jesli udało się dodać wierzchołek.
  * Wartość @p false wpp.
  */
-bool addRoadsListNode(RoadsList *list, void *city, unsigned length,
-                      int builtYear);
+bool addRoadsListNode(RoadsList *list, void *city, Road *road);
 
 #endif  // __ROADS_LIST_H__
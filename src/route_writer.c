@@ -0,0 +1,126 @@
+#include "route_writer.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "defines.h"
+
+static bool writeToFile(void *data, const char *chunk, size_t length) {
+  return fwrite(chunk, sizeof(char), length, (FILE *)data) == length;
+}
+
+static bool writeToBuffer(void *data, const char *chunk, size_t length) {
+  RouteBuffer *buffer = (RouteBuffer *)data;
+  size_t begin = buffer->total;
+  buffer->total += length;
+
+  // pomijamy znaki sprzed okna i te, które się w nim nie mieszczą
+  if (begin < buffer->position) {
+    size_t skipped = buffer->position - begin;
+    if (skipped >= length) {
+      return true;
+    }
+    chunk += skipped;
+    length -= skipped;
+  }
+  size_t room = buffer->capacity - buffer->length;
+  if (length > room) {
+    length = room;
+  }
+
+  memcpy(buffer->chars + buffer->length, chunk, length);
+  buffer->length += length;
+  return true;
+}
+
+RouteSink fileRouteSink(FILE *file) {
+  RouteSink sink = {writeToFile, file};
+  return sink;
+}
+
+RouteSink bufferRouteSink(RouteBuffer *buffer) {
+  RouteSink sink = {writeToBuffer, buffer};
+  return sink;
+}
+
+RouteSink callbackRouteSink(WriteChunkFunction write, void *data) {
+  RouteSink sink = {write, data};
+  return sink;
+}
+
+void initRouteBuffer(RouteBuffer *buffer, char *chars, size_t capacity) {
+  buffer->chars = chars;
+  buffer->capacity = capacity;
+  buffer->length = 0;
+  buffer->position = 0;
+  buffer->total = 0;
+}
+
+bool nextRouteBufferWindow(RouteBuffer *buffer) {
+  buffer->position += buffer->length;
+  bool hasMore = buffer->position < buffer->total;
+  buffer->length = 0;
+  buffer->total = 0;
+  return hasMore;
+}
+
+void initRouteWriter(RouteWriter *writer, RouteSink *sink) {
+  writer->sink = sink;
+  writer->used = 0;
+  writer->failed = false;
+}
+
+static void flushChunk(RouteWriter *writer) {
+  if (writer->used > 0 && !writer->failed) {
+    writer->failed =
+        !writer->sink->write(writer->sink->data, writer->chunk, writer->used);
+  }
+  writer->used = 0;
+}
+
+void writeChars(RouteWriter *writer, const char *chars, size_t length) {
+  if (writer->used + length > ROUTE_WRITER_CHUNK) {
+    flushChunk(writer);
+    if (length > ROUTE_WRITER_CHUNK) {
+      if (!writer->failed) {
+        writer->failed = !writer->sink->write(writer->sink->data, chars,
+                                              length);
+      }
+      return;
+    }
+  }
+  memcpy(writer->chunk + writer->used, chars, length);
+  writer->used += length;
+}
+
+void writeChar(RouteWriter *writer, char c) {
+  if (writer->used == ROUTE_WRITER_CHUNK) {
+    flushChunk(writer);
+  }
+  writer->chunk[writer->used++] = c;
+}
+
+void writeUnsigned(RouteWriter *writer, unsigned val) {
+  char digits[MAX_NUMBER_LENGTH];
+  size_t n = MAX_NUMBER_LENGTH;
+  do {
+    digits[--n] = (char)('0' + val % 10);
+    val /= 10;
+  } while (val > 0);
+  writeChars(writer, digits + n, MAX_NUMBER_LENGTH - n);
+}
+
+void writeInt(RouteWriter *writer, int val) {
+  if (val < 0) {
+    writeChar(writer, '-');
+    writeUnsigned(writer, 0U - (unsigned)val);
+  } else {
+    writeUnsigned(writer, (unsigned)val);
+  }
+}
+
+bool flushRouteWriter(RouteWriter *writer) {
+  flushChunk(writer);
+  return !writer->failed;
+}
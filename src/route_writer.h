@@ -0,0 +1,127 @@
+/** @file
+ * Interfejs zapisu opisów dróg krajowych do dowolnego ujścia
+ */
+
+#ifndef __ROUTE_WRITER_H__
+#define __ROUTE_WRITER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "defines.h"
+
+/** @brief Funkcja przyjmująca kolejny fragment opisu.
+ * @param[in,out] data – dane ujścia;
+ * @param[in] chunk    – wskaźnik na fragment opisu (bez znaku '\0');
+ * @param[in] length   – długość fragmentu.
+ * @return Wartość @p true, jeśli fragment został przyjęty.
+ * Wartość @p false, jeśli wystąpił błąd i zapis należy przerwać.
+ */
+typedef bool (*WriteChunkFunction)(void *data, const char *chunk,
+                                   size_t length);
+
+/**
+ * Ujście, do którego zapisywany jest opis drogi krajowej.
+ */
+typedef struct RouteSink {
+  WriteChunkFunction write;  ///< funkcja przyjmująca kolejne fragmenty
+  void *data;                ///< dane przekazywane funkcji @p write
+} RouteSink;
+
+/**
+ * Bufor o stałym rozmiarze, do którego trafia okno opisu zaczynające się
+ * w miejscu @p position. Po każdym zapisie @p total zawiera długość całego
+ * opisu, więc zapis można wznowić od kolejnego okna.
+ */
+typedef struct RouteBuffer {
+  char *chars;      ///< tablica znaków bufora
+  size_t capacity;  ///< rozmiar tablicy @p chars
+  size_t length;    ///< liczba znaków zapisanych w ostatnim oknie
+  size_t position;  ///< początek okna w opisie
+  size_t total;     ///< liczba znaków opisu przekazanych do ujścia
+} RouteBuffer;
+
+/**
+ * Struktura zbierająca drobne fragmenty opisu i przekazująca je do ujścia
+ * większymi porcjami.
+ */
+typedef struct RouteWriter {
+  RouteSink *sink;                 ///< ujście opisu
+  char chunk[ROUTE_WRITER_CHUNK];  ///< bufor na nieprzekazane znaki
+  size_t used;                     ///< liczba znaków w buforze @p chunk
+  bool failed;                     ///< informacja, czy ujście zgłosiło błąd
+} RouteWriter;
+
+/** @brief Tworzy ujście zapisujące do pliku.
+ * @param[in] file – wskaźnik na plik.
+ * @return Ujście.
+ */
+RouteSink fileRouteSink(FILE *file);
+
+/** @brief Tworzy ujście zapisujące do bufora o stałym rozmiarze.
+ * @param[in,out] buffer – wskaźnik na bufor.
+ * @return Ujście.
+ */
+RouteSink bufferRouteSink(RouteBuffer *buffer);
+
+/** @brief Tworzy ujście przekazujące fragmenty opisu do funkcji.
+ * @param[in] write – funkcja przyjmująca fragmenty;
+ * @param[in] data  – dane przekazywane funkcji @p write.
+ * @return Ujście.
+ */
+RouteSink callbackRouteSink(WriteChunkFunction write, void *data);
+
+/** @brief Przygotowuje bufor do zapisu pierwszego okna opisu.
+ * @param[out] buffer  – wskaźnik na bufor;
+ * @param[in] chars    – tablica znaków;
+ * @param[in] capacity – rozmiar tablicy @p chars.
+ */
+void initRouteBuffer(RouteBuffer *buffer, char *chars, size_t capacity);
+
+/** @brief Przesuwa bufor na kolejne okno opisu.
+ * @param[in,out] buffer – wskaźnik na bufor.
+ * @return Wartość @p true, jeśli po ostatnim oknie zostały jeszcze znaki
+ * opisu. Wartość @p false, jeśli opis został zapisany w całości.
+ */
+bool nextRouteBufferWindow(RouteBuffer *buffer);
+
+/** @brief Przygotowuje strukturę do zapisu do ujścia @p sink.
+ * @param[out] writer – wskaźnik na strukturę;
+ * @param[in] sink    – wskaźnik na ujście.
+ */
+void initRouteWriter(RouteWriter *writer, RouteSink *sink);
+
+/** @brief Zapisuje ciąg znaków.
+ * @param[in,out] writer – wskaźnik na strukturę;
+ * @param[in] chars      – wskaźnik na znaki;
+ * @param[in] length     – liczba znaków.
+ */
+void writeChars(RouteWriter *writer, const char *chars, size_t length);
+
+/** @brief Zapisuje jeden znak.
+ * @param[in,out] writer – wskaźnik na strukturę;
+ * @param[in] c          – znak.
+ */
+void writeChar(RouteWriter *writer, char c);
+
+/** @brief Zapisuje liczbę w zapisie dziesiętnym.
+ * @param[in,out] writer – wskaźnik na strukturę;
+ * @param[in] val        – liczba.
+ */
+void writeInt(RouteWriter *writer, int val);
+
+/** @brief Zapisuje liczbę nieujemną w zapisie dziesiętnym.
+ * @param[in,out] writer – wskaźnik na strukturę;
+ * @param[in] val        – liczba.
+ */
+void writeUnsigned(RouteWriter *writer, unsigned val);
+
+/** @brief Przekazuje do ujścia wszystkie zebrane znaki.
+ * @param[in,out] writer – wskaźnik na strukturę.
+ * @return Wartość @p true, jeśli ujście przyjęło cały opis.
+ * Wartość @p false, jeśli ujście zgłosiło błąd.
+ */
+bool flushRouteWriter(RouteWriter *writer);
+
+#endif  // __ROUTE_WRITER_H__
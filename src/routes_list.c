@@ -8,12 +8,14 @@
 RoutesListElement newRoutesListElem(unsigned routeId) {
   RoutesListElement elem;
   elem.routeId = routeId;
+  elem.section = -1;
   return elem;
 }
 
-RoutesListNode *newRoutesListNode(RoutesListNode *prev, RoutesListElement elem,
+RoutesListNode *newRoutesListNode(NodePools *pools, RoutesListNode *prev,
+                                  RoutesListElement elem,
                                   RoutesListNode *next) {
-  RoutesListNode *node = (RoutesListNode *)malloc(sizeof(RoutesListNode));
+  RoutesListNode *node = (RoutesListNode *)allocNode(&pools->routesNodes);
   if (node == NULL) {
     return NULL;
   }
@@ -23,27 +25,23 @@ RoutesListNode *newRoutesListNode(RoutesListNode *prev, RoutesListElement elem,
   return node;
 }
 
-RoutesList *newRoutesList() {
-  RoutesList *list = (RoutesList *)malloc(sizeof(RoutesList));
+RoutesList *newRoutesList(NodePools *pools) {
+  RoutesList *list = (RoutesList *)allocNode(&pools->routesLists);
   if (list == NULL) {
     return NULL;
   }
 
-  list->head = newRoutesListNode(NULL, newRoutesListElem(0), NULL);
-  if (list->head == NULL) {
-    free(list);
-    list = NULL;
-    return NULL;
-  }
-
-  list->tail = newRoutesListNode(list->head, newRoutesListElem(0), NULL);
-  if (list->tail == NULL) {
-    free(list);
-    list = NULL;
-    return NULL;
-  }
+  list->pools = pools;
+  list->head = &list->sentinels[0];
+  list->tail = &list->sentinels[1];
 
+  list->head->prev = NULL;
+  list->head->elem = newRoutesListElem(0);
   list->head->next = list->tail;
+
+  list->tail->prev = list->head;
+  list->tail->elem = newRoutesListElem(0);
+  list->tail->next = NULL;
   return list;
 }
 
@@ -51,7 +49,8 @@ bool isValidRoutesListNode(RoutesListNode *node) {
   return node != NULL && node->next != NULL && node->prev != NULL;
 }
 
-void removeRoutesListNode(RoutesListNode *node) {
+void removeRoutesListNode(RoutesList *list, RoutesListNode *node) {
+  assert(list != NULL);
   assert(node != NULL);
   assert(node->next != NULL);
   assert(node->prev != NULL);
@@ -59,9 +58,9 @@ void removeRoutesListNode(RoutesListNode *node) {
   node->next->prev = node->prev;
   node->prev->next = node->next;
 
-  free(node);
-  node = NULL;
+  freeNode(&list->pools->routesNodes, node);
 }
+
 void removeRoutesListNodeById(RoutesList *list, unsigned routeId) {
   assert(list);
 
@@ -70,7 +69,7 @@ void removeRoutesListNodeById(RoutesList *list, unsigned routeId) {
 
   while (isValidRoutesListNode(iter)) {
     if (iter->elem.routeId == routeId) {
-      removeRoutesListNode(iter);
+      removeRoutesListNode(list, iter);
       return;
     }
     iter = iter->next;
@@ -83,7 +82,7 @@ void popBackRoutesList(RoutesList *list) {
   assert(list->tail != NULL);
 
   if (isValidRoutesListNode(list->tail->prev)) {
-    removeRoutesListNode(list->tail->prev);
+    removeRoutesListNode(list, list->tail->prev);
   }
 }
 
@@ -94,20 +93,17 @@ void deleteRoutesList(RoutesList *list) {
   while (isValidRoutesListNode(list->tail->prev)) {
     popBackRoutesList(list);
   }
-  free(list->head);
-  free(list->tail);
-  free(list);
-  list = NULL;
+  freeNode(&list->pools->routesLists, list);
 }
 
-bool addRoutesListNode(RoutesList *list, unsigned route) {
-  RoutesListNode *node =
-      newRoutesListNode(list->tail->prev, newRoutesListElem(route), list->tail);
+RoutesListNode *addRoutesListNode(RoutesList *list, unsigned route) {
+  RoutesListNode *node = newRoutesListNode(
+      list->pools, list->tail->prev, newRoutesListElem(route), list->tail);
   if (node == NULL) {
-    return false;
+    return NULL;
   }
 
   list->tail->prev->next = node;
   list->tail->prev = node;
-  return true;
+  return node;
 }
@@ -7,11 +7,14 @@
 
 #include <stdbool.h>
 
+#include "node_pool.h"
+
 /**
  * Element węzła listy dróg krajowych.
  */
 typedef struct RoutesListElement {
   unsigned routeId;  ///< numer drogi krajowej
+  int section;  ///< indeks odcinka w tablicy odcinków drogi krajowej
 } RoutesListElement;
 
 /**
@@ -25,10 +28,13 @@ typedef struct RoutesListNode {
 
 /**
  * Lista dróg, reprezentowana przez głowę i ogon.
+ * Głowa i ogon są przechowywane w samej strukturze listy.
  */
 typedef struct RoutesList {
-  RoutesListNode *head;  ///< wskaźnik na głowę listy
-  RoutesListNode *tail;  ///< wskaźnik na ogon listy
+  RoutesListNode *head;         ///< wskaźnik na głowę listy
+  RoutesListNode *tail;         ///< wskaźnik na ogon listy
+  RoutesListNode sentinels[2];  ///< wartownicy: głowa i ogon
+  NodePools *pools;             ///< pule listy i jej węzłów
 } RoutesList;
 
 /** @brief Tworzy nowy element węzła listy.
@@ -39,18 +45,21 @@ RoutesListElement newRoutesListElem(unsigned routeId);
 
 /** @brief Tworzy nowy węzeł listy.
  * Tworzy nowy węzeł, którego sąsiadami są prev i next.
+ * @param[in] pools – wskaźnik na pule węzłów;
  * @param[in] prev  – wskaźnik na poprzedni element w liście
  * @param[in] elem  – element węzła;
  * @param[in] next  – wskaźnik na następny element w liście.
  * @return Wskaźnik na węzeł.
  */
-RoutesListNode *newRoutesListNode(RoutesListNode *prev, RoutesListElement elem,
-                                  RoutesListNode *next);
+RoutesListNode *newRoutesListNode(NodePools *pools, RoutesListNode *prev,
+                                  RoutesListElement elem, RoutesListNode *next);
 
 /** @brief Tworzy nową listę.
- * @return Wskaźnik na listę.
+ * Lista i jej węzły są przydzielane z pul @p pools.
+ * @param[in] pools – wskaźnik na pule węzłów.
+ * @return Wskaźnik na listę lub NULL, gdy nie udało się zaalokować pamięci.
  */
-RoutesList *newRoutesList();
+RoutesList *newRoutesList(NodePools *pools);
 
 /** @brief Sprawdza, czy dany wierzchołek jest poprawnym wierzchołkiem listy.
  * @param[in] node - wskaźnik na dany wierzchołek
@@ -60,11 +69,11 @@ RoutesList *newRoutesList();
 bool isValidRoutesListNode(RoutesListNode *node);
 
 /** @brief Usuwa węzeł listy.
- * Usuwa węzeł wskazywany przez @p node.
- * Nic nie robi, jeśli wskaźnik ten ma wartość NULL.
- * @param[in] node – wskaźnik na usuwany wierzchołek.
+ * Usuwa węzeł wskazywany przez @p node i zwraca go do puli listy.
+ * @param[in,out] list – wskaźnik na listę, do której należy węzeł;
+ * @param[in] node     – wskaźnik na usuwany wierzchołek.
  */
-void removeRoutesListNode(RoutesListNode *node);
+void removeRoutesListNode(RoutesList *list, RoutesListNode *node);
 
 /** @brief Usuwa ostatni węzeł listy.
  * Usuwa ostatni węzeł listy wskazywanej przez @p list.
@@ -83,10 +92,10 @@ void deleteRoutesList(RoutesList *list);
 /** @brief Tworzy i dodaje wierzchołek do listy.
  * @param[in] list  – wskaźnik na listę.
  * @param[in] routeId  – numer drogi krajowej
- * @return Wartość @p true, jesli udało się dodać wierzchołek;
- * Wartość @p false wpp.
+ * @return Wskaźnik na dodany wierzchołek lub NULL, gdy nie udało się
+ * zaalokować pamięci.
  */
-bool addRoutesListNode(RoutesList *list, unsigned routeId);
+RoutesListNode *addRoutesListNode(RoutesList *list, unsigned routeId);
 
 /** @brief Usuwa węzeł listy o wartości @p routeId.
  * Wyszukuje węzeł z listy, który ma wartość @p routeId i go usuwa.
@@ -0,0 +1,99 @@
+#include "search_workspace.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "defines.h"
+#include "heap.h"
+
+SearchWorkspace *newSearchWorkspace() {
+  SearchWorkspace *workspace =
+      (SearchWorkspace *)malloc(sizeof(SearchWorkspace));
+  if (workspace == NULL) {
+    return NULL;
+  }
+
+  workspace->queue = newHeap();
+  workspace->meetings = newHeap();
+  if (workspace->queue == NULL || workspace->meetings == NULL) {
+    deleteHeap(workspace->queue);
+    deleteHeap(workspace->meetings);
+    free(workspace);
+    return NULL;
+  }
+
+  workspace->labels = NULL;
+  workspace->capacity = 0;
+  workspace->epoch = 0;
+  return workspace;
+}
+
+void deleteSearchWorkspace(SearchWorkspace *workspace) {
+  if (workspace == NULL) {
+    return;
+  }
+  deleteHeap(workspace->queue);
+  deleteHeap(workspace->meetings);
+  free(workspace->labels);
+  free(workspace);
+}
+
+bool prepareSearchWorkspace(SearchWorkspace *workspace, int numOfCities) {
+  assert(workspace);
+
+  if (workspace->capacity < numOfCities) {
+    int capacity = workspace->capacity > 0 ? workspace->capacity : 1;
+    while (capacity < numOfCities) {
+      capacity *= 2;
+    }
+
+    SearchLabel *labels = (SearchLabel *)realloc(
+        workspace->labels, capacity * sizeof(SearchLabel));
+    if (labels == NULL) {
+      return false;
+    }
+
+    memset(labels + workspace->capacity, 0,
+           (capacity - workspace->capacity) * sizeof(SearchLabel));
+    workspace->labels = labels;
+    workspace->capacity = capacity;
+  }
+
+  workspace->epoch++;
+  if (workspace->epoch == 0) {
+    // licznik się przekręcił, więc stare znaczniki mogłyby znów być aktualne
+    for (int i = 0; i < workspace->capacity; i++) {
+      workspace->labels[i].stamp = 0;
+    }
+    workspace->epoch = 1;
+  }
+
+  clearHeap(workspace->queue);
+  clearHeap(workspace->meetings);
+  return true;
+}
+
+bool hasSearchLabel(SearchWorkspace *workspace, int id) {
+  assert(workspace);
+  assert(0 <= id && id < workspace->capacity);
+  return workspace->labels[id].stamp == workspace->epoch;
+}
+
+SearchLabel *getSearchLabel(SearchWorkspace *workspace, int id) {
+  assert(workspace);
+  assert(0 <= id && id < workspace->capacity);
+
+  SearchLabel *label = &workspace->labels[id];
+  if (label->stamp != workspace->epoch) {
+    label->stamp = workspace->epoch;
+    label->dist = UNSIGNED_INF;
+    label->minRepairYear = INF;
+    label->vis = false;
+    label->isCorrect = false;
+    label->isOnPath = false;
+    label->prev = -1;
+  }
+  return label;
+}
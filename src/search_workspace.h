@@ -0,0 +1,79 @@
+/** @file
+ * Interfejs przestrzeni roboczej algorytmu wyszukiwania najkrótszych dróg
+ */
+
+#ifndef __SEARCH_WORKSPACE_H__
+#define __SEARCH_WORKSPACE_H__
+
+#include <stdbool.h>
+
+#include "heap.h"
+
+/**
+ * Etykieta miasta, wyznaczana w trakcie wyszukiwania.
+ */
+typedef struct SearchLabel {
+  unsigned stamp;     ///< numer wyszukiwania, w którym ustawiono etykietę
+  unsigned dist;      ///< długość najkrótszej znalezionej drogi
+  int minRepairYear;  ///< najstarszy rok budowy lub remontu na tej drodze
+  bool vis;           ///< informacja, czy etykieta jest już ostateczna
+  bool isCorrect;     ///< informacja, czy droga jest wyznaczona jednoznacznie
+  bool isOnPath;      ///< informacja, czy miasto leży na najkrótszej drodze
+  int prev;           ///< numer poprzedniego miasta na drodze lub -1
+} SearchLabel;
+
+/**
+ * Struktura przechowująca pamięć wykorzystywaną przez kolejne wyszukiwania.
+ * Etykieta miasta jest aktualna tylko wtedy, gdy jej pole @p stamp jest równe
+ * polu @p epoch, dzięki czemu przygotowanie nowego wyszukiwania nie wymaga
+ * czyszczenia całej tablicy.
+ */
+typedef struct SearchWorkspace {
+  SearchLabel *labels;  ///< tablica etykiet, indeksowana numerami miast
+  int capacity;         ///< rozmiar tablicy etykiet
+  unsigned epoch;       ///< numer bieżącego wyszukiwania
+  Heap *queue;          ///< kolejka priorytetowa wyszukiwania
+  Heap *meetings;       ///< miasta, w których spotkały się dwa wyszukiwania
+} SearchWorkspace;
+
+/** @brief Tworzy nową strukturę.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci.
+ */
+SearchWorkspace *newSearchWorkspace();
+
+/** @brief Usuwa strukturę.
+ * Nic nie robi, jeśli wskaźnik @p workspace ma wartość NULL.
+ * @param[in] workspace – wskaźnik na usuwaną strukturę.
+ */
+void deleteSearchWorkspace(SearchWorkspace *workspace);
+
+/** @brief Przygotowuje strukturę do nowego wyszukiwania.
+ * Unieważnia wszystkie etykiety i opróżnia kolejki. Powiększa tablicę etykiet,
+ * jeśli jest mniejsza niż @p numOfCities.
+ * @param[in,out] workspace – wskaźnik na strukturę;
+ * @param[in] numOfCities   – liczba miast w mapie.
+ * @return Wartość @p true, jeśli się udało.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+bool prepareSearchWorkspace(SearchWorkspace *workspace, int numOfCities);
+
+/** @brief Sprawdza, czy etykieta miasta była ustawiana w bieżącym
+ * wyszukiwaniu.
+ * @param[in] workspace – wskaźnik na strukturę;
+ * @param[in] id        – numer miasta.
+ * @return Wartość @p true, jeśli etykieta była ustawiana.
+ * Wartość @p false wpp.
+ */
+bool hasSearchLabel(SearchWorkspace *workspace, int id);
+
+/** @brief Zwraca etykietę miasta o numerze @p id.
+ * Jeśli etykieta nie była ustawiana w bieżącym wyszukiwaniu, to nadaje jej
+ * wartości początkowe.
+ * @param[in,out] workspace – wskaźnik na strukturę;
+ * @param[in] id            – numer miasta.
+ * @return Wskaźnik na etykietę miasta.
+ */
+SearchLabel *getSearchLabel(SearchWorkspace *workspace, int id);
+
+#endif  // __SEARCH_WORKSPACE_H__
@@ -1,63 +1,62 @@
-#include <errno.h>
+#include "strings.h"
+
+#include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
-#include <strings.h>
 
 #include "defines.h"
 
-bool strIsValidNumber(char *str) {
+bool strParseNumber(const char *str, long long *value, bool *overflow) {
   if (str == NULL) {
     return false;
   }
-  if (str[0] == '-') {
+
+  bool isNegative = (*str == '-');
+  if (isNegative) {
     str++;
   }
-  while (*str) {
-    if (*str < '0' || '9' < *str) {
+
+  unsigned long long magnitude = 0;
+  *overflow = false;
+  for (; *str; str++) {
+    unsigned digit = (unsigned char)*str - '0';
+    if (digit > 9) {
       return false;
     }
-    str++;
+    if (magnitude > ((unsigned long long)LLONG_MAX - digit) / 10) {
+      *overflow = true;
+    } else {
+      magnitude = magnitude * 10 + digit;
+    }
   }
+
+  *value = isNegative ? -(long long)magnitude : (long long)magnitude;
   return true;
 }
 
-int strGetYear(char *str) {
-  if (!strIsValidNumber(str)) {
+// Zwraca wartość liczby zapisanej w napisie @p str, jeśli należy ona do
+// przedziału [@p min, @p max], a wpp. 0.
+static long long strGetNumberInRange(const char *str, long long min,
+                                     long long max) {
+  long long value;
+  bool overflow;
+  if (!strParseNumber(str, &value, &overflow) || overflow || value < min ||
+      value > max) {
     return 0;
   }
-
-  long long year = strtoll(str, NULL, 10);
-  if (errno == ERANGE || year > MAX_YEAR || year < MIN_YEAR) {
-    errno = 0;
-    year = 0;
-  }
-  return (int)year;
+  return value;
 }
 
-unsigned strGetRouteId(char *str) {
-  if (!strIsValidNumber(str)) {
-    return 0;
-  }
-
-  long long routeId = strtoll(str, NULL, 10);
-  if (errno == ERANGE || routeId < 0 || routeId > MAX_ROUTE_ID) {
-    errno = 0;
-    routeId = 0;
-  }
-  return (unsigned)routeId;
+int strGetYear(const char *str) {
+  return (int)strGetNumberInRange(str, MIN_YEAR, MAX_YEAR);
 }
 
-unsigned strGetLength(char *str) {
-  if (!strIsValidNumber(str)) {
-    return 0;
-  }
+unsigned strGetRouteId(const char *str) {
+  return (unsigned)strGetNumberInRange(str, 0, MAX_ROUTE_ID);
+}
 
-  long long length = strtoll(str, NULL, 10);
-  if (errno == ERANGE || length < 0 || length > MAX_LENGTH) {
-    errno = 0;
-    length = 0;
-  }
-  return (unsigned)length;
+unsigned strGetLength(const char *str) {
+  return (unsigned)strGetNumberInRange(str, 0, MAX_LENGTH);
 }
 
 bool isValidCityName(const char *city) {
@@ -7,11 +7,19 @@
 
 #include <stdbool.h>
 
-/** @brief Sprawdza, czy napis przechowuje poprawną liczbę całkowitą int.
- * @param[in] str  – wskaźnik na napis.
- * @return Wartość, przechowywana przez napis, bądź 0 jeśli jest niepoprawna.
+/** @brief Sprawdza poprawność napisu i wyznacza wartość liczby.
+ * Napis jest poprawną liczbą, jeśli składa się z opcjonalnego znaku '-'
+ * i samych cyfr. Sprawdzenie i wyznaczenie wartości odbywa się w jednym
+ * przejściu napisu.
+ * @param[in] str       – wskaźnik na napis;
+ * @param[out] value    – wartość liczby, jeśli @p overflow ma wartość
+ * @p false;
+ * @param[out] overflow – informacja, czy wartość bezwzględna liczby
+ * przekracza największą wartość typu long long.
+ * @return Wartość @p true, jeśli napis jest poprawną liczbą.
+ * Wartość @p false, jeśli nie jest lub @p str ma wartość NULL.
  */
-bool strIsValidNumber(char *str);
+bool strParseNumber(const char *str, long long *value, bool *overflow);
 
 /** @brief Zamienia stringa na inta.
  * Jeżeli string jest poprawną liczbą int, zamienia go na tą liczbę.
@@ -19,7 +27,7 @@ bool strIsValidNumber(char *str);
  * @param[in] str  – wskaźnik na napis.
  * @return Wartość, przechowywana przez napis, bądź 0 jeśli jest niepoprawna.
  */
-int strGetYear(char *str);
+int strGetYear(const char *str);
 
 /** @brief Zamienia stringa na unsigned pomiędzy 0 a 999.
  * Jeżeli string jest poprawnym routeId, zamienia go na tą liczbę.
@@ -27,7 +35,7 @@ int strGetYear(char *str);
  * @param[in] str  – wskaźnik na napis.
  * @return Wartość, przechowywana przez napis, bądź 0 jeśli jest niepoprawna.
  */
-unsigned strGetRouteId(char *str);
+unsigned strGetRouteId(const char *str);
 
 /** @brief Zamienia stringa na unsigned.
  * Jeżeli string jest poprawną liczbą unsigned, zamienia go na tą liczbę.
@@ -35,7 +43,7 @@ unsigned strGetRouteId(char *str);
  * @param[in] str  – wskaźnik na napis.
  * @return Wartość, przechowywana przez napis, bądź 0 jeśli jest niepoprawna.
  */
-unsigned strGetLength(char *str);
+unsigned strGetLength(const char *str);
 
 /** @brief Sprawdza poprawność nazwy miasta.
  * Sprawdza, czy nazwa miasta nie zawiera niedozwolonych znaków.
@@ -2,73 +2,165 @@
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
-#include "children_list.h"
+#include "defines.h"
+#include "roads_index.h"
 #include "roads_list.h"
 
-Trie *newTrieNode() {
-  Trie *node = (Trie *)malloc(sizeof(Trie));
+Trie *newTrieNode(NodePools *pools) {
+  Trie *node = (Trie *)allocNode(&pools->trieNodes);
   if (node == NULL) {
     return NULL;
   }
 
-  node->children = newChildrenList();
-  node->roads = newRoadsList();
+  node->numOfChildren = 0;
+  node->indexed = NULL;
+  node->table = NULL;
   node->isLeaf = false;
   node->id = -1;
+  node->roads = NULL;
+  node->degree = 0;
+  node->index = NULL;
 
-  node->character = '\0';
-  node->parent = NULL;
+  node->label = NULL;
+  node->labelLength = 0;
 
-  if (node->children == NULL || node->roads == NULL) {
-    deleteChildrenList(node->children);
-    deleteRoadsList(node->roads);
-    free(node->children);
-    free(node->roads);
-    free(node);
-    return NULL;
+  return node;
+}
+
+// Zwraca dziecko węzła @p node, odpowiadające znakowi @p character, lub NULL.
+static Trie *findChild(Trie *node, unsigned char character) {
+  if (node->table != NULL) {
+    return node->table[character];
   }
 
-  return node;
+  if (node->indexed != NULL) {
+    int slot = node->indexed->slots[character];
+    return slot > 0 ? node->indexed->children[slot - 1] : NULL;
+  }
+
+  for (int i = 0; i < node->numOfChildren && node->keys[i] <= character; i++) {
+    if (node->keys[i] == character) {
+      return node->children[i];
+    }
+  }
+  return NULL;
 }
 
-void deleteTrie(Trie *node) {
-  if (node == NULL) {
-    return;
+// Przenosi dzieci węzła @p node do większej reprezentacji, jeśli obecna
+// jest pełna.
+static bool growChildren(NodePools *pools, Trie *node) {
+  if (node->numOfChildren == TRIE_INLINE_CHILDREN) {
+    TrieIndexedChildren *indexed =
+        (TrieIndexedChildren *)allocNode(&pools->trieIndexed);
+    if (indexed == NULL) {
+      return false;
+    }
+
+    memset(indexed->slots, 0, sizeof(indexed->slots));
+    for (int i = 0; i < node->numOfChildren; i++) {
+      indexed->slots[node->keys[i]] = i + 1;
+      indexed->children[i] = node->children[i];
+    }
+    node->indexed = indexed;
+  } else if (node->numOfChildren == TRIE_INDEXED_CHILDREN) {
+    Trie **table = (Trie **)allocNode(&pools->trieTables);
+    if (table == NULL) {
+      return false;
+    }
+
+    for (int c = 0; c < TRIE_TABLE_SIZE; c++) {
+      int slot = node->indexed->slots[c];
+      table[c] = slot > 0 ? node->indexed->children[slot - 1] : NULL;
+    }
+    freeNode(&pools->trieIndexed, node->indexed);
+    node->indexed = NULL;
+    node->table = table;
+  }
+  return true;
+}
+
+// Dodaje do węzła @p node dziecko @p child, odpowiadające znakowi
+// @p character.
+static bool addChild(NodePools *pools, Trie *node, unsigned char character,
+                     Trie *child) {
+  if (!growChildren(pools, node)) {
+    return false;
   }
 
-  if (node->children != NULL) {
-    ChildrenListNode *iter = node->children->head->next;
-    while (isValidChildrenListNode(iter)) {
-      deleteTrie(iter->elem.child);
-      iter = iter->next;
+  if (node->table != NULL) {
+    node->table[character] = child;
+  } else if (node->indexed != NULL) {
+    node->indexed->children[node->numOfChildren] = child;
+    node->indexed->slots[character] = node->numOfChildren + 1;
+  } else {
+    int pos = node->numOfChildren;
+    while (pos > 0 && node->keys[pos - 1] > character) {
+      node->keys[pos] = node->keys[pos - 1];
+      node->children[pos] = node->children[pos - 1];
+      pos--;
     }
-    deleteChildrenList(node->children);
+    node->keys[pos] = character;
+    node->children[pos] = child;
   }
-  if (node->roads != NULL) {
-    deleteRoadsList(node->roads);
+
+  node->numOfChildren++;
+  return true;
+}
+
+// Zastępuje dziecko węzła @p node, odpowiadające znakowi @p character,
+// węzłem @p child.
+static void replaceChild(Trie *node, unsigned char character, Trie *child) {
+  if (node->table != NULL) {
+    node->table[character] = child;
+  } else if (node->indexed != NULL) {
+    node->indexed->children[node->indexed->slots[character] - 1] = child;
+  } else {
+    for (int i = 0; i < node->numOfChildren; i++) {
+      if (node->keys[i] == character) {
+        node->children[i] = child;
+        return;
+      }
+    }
+    assert(false);
   }
-  free(node);
+}
+
+// Ustawia etykietę węzła @p node na kopię @p length znaków napisu @p label.
+// Krótkie etykiety są przechowywane w samym węźle.
+static bool setLabel(NodePools *pools, Trie *node, const char *label,
+                     int length) {
+  char *copy = node->inlineLabel;
+  if (length > TRIE_INLINE_LABEL) {
+    copy = allocBytes(&pools->trieLabels, length);
+    if (copy == NULL) {
+      return false;
+    }
+  }
+
+  memcpy(copy, label, length);
+  node->label = copy;
+  node->labelLength = length;
+  return true;
 }
 
 Trie *getNodePtr(Trie *root, const char *city) {
   Trie *curr = root;
 
   while (*city) {
-    Trie *next = NULL;
-    ChildrenListNode *iter = curr->children->head->next;
-    while (isValidChildrenListNode(iter)) {
-      if (iter->elem.character == *city) {
-        next = iter->elem.child;
-        break;
-      }
-      iter = iter->next;
-    }
-    if (next == NULL) {
+    curr = findChild(curr, (unsigned char)*city);
+    if (curr == NULL) {
       return NULL;
     }
-    curr = next;
-    city++;
+    // pierwszy znak etykiety został sprawdzony przy wyborze dziecka, a napis
+    // @p city kończy się znakiem '\0', którego nie ma w etykietach
+    for (int i = 1; i < curr->labelLength; i++) {
+      if (city[i] != curr->label[i]) {
+        return NULL;
+      }
+    }
+    city += curr->labelLength;
   }
 
   if (!curr->isLeaf) {
@@ -77,116 +169,189 @@ Trie *getNodePtr(Trie *root, const char *city) {
   return curr;
 }
 
-bool insertStr(Trie *root, const char *city, int id) {
+Trie *insertStr(NodePools *pools, Trie *root, const char *city, int id) {
   Trie *curr = root;
 
   while (*city) {
-    Trie *next = NULL;
-    ChildrenListNode *iter = curr->children->head->next;
-    while (isValidChildrenListNode(iter)) {
-      if (iter->elem.character == *city) {
-        next = iter->elem.child;
-        break;
+    unsigned char character = (unsigned char)*city;
+    Trie *next = findChild(curr, character);
+
+    if (next == NULL) {
+      next = newTrieNode(pools);
+      if (next == NULL || !setLabel(pools, next, city, (int)strlen(city))) {
+        freeNode(&pools->trieNodes, next);
+        return NULL;
+      }
+      if (!addChild(pools, curr, character, next)) {
+        freeNode(&pools->trieNodes, next);
+        return NULL;
       }
-      iter = iter->next;
+
+      curr = next;
+      break;
     }
 
-    if (next == NULL) {
-      addChildrenListNode(curr->children, *city);
-      curr->children->tail->prev->elem.child = newTrieNode();
+    int common = 0;
+    while (common < next->labelLength && city[common] == next->label[common]) {
+      common++;
+    }
 
-      if (curr->children->tail->prev->elem.child == NULL) {
-        return false;
+    if (common < next->labelLength) {
+      // dzieli krawędź, wstawiając węzeł odpowiadający wspólnemu prefiksowi
+      Trie *middle = newTrieNode(pools);
+      if (middle == NULL) {
+        return NULL;
       }
 
-      curr->children->tail->prev->elem.child->character = *city;
-      curr->children->tail->prev->elem.child->parent = curr;
-      next = curr->children->tail->prev->elem.child;
+      if (common <= TRIE_INLINE_LABEL) {
+        setLabel(pools, middle, next->label, common);
+      } else {
+        middle->label = next->label;
+        middle->labelLength = common;
+      }
+      replaceChild(curr, character, middle);
+
+      next->label += common;
+      next->labelLength -= common;
+      addChild(pools, middle, (unsigned char)next->label[0], next);
+      next = middle;
     }
+
     curr = next;
-    city++;
+    city += common;
+  }
+
+  if (curr->roads == NULL) {
+    curr->roads = newRoadsList(pools);
+    if (curr->roads == NULL) {
+      return NULL;
+    }
   }
   curr->isLeaf = true;
   curr->id = id;
-  return true;
+  return curr;
 }
 
-bool isNeighbour(Trie *city, Trie *neighbour) {
-  if (city == NULL || neighbour == NULL) {
-    return false;
+// Zwraca węzeł listy dróg miasta @p city, prowadzący do miasta @p neighbour,
+// lub NULL, jeśli miasta nie sąsiadują.
+static RoadsListNode *findRoadNode(Trie *city, Trie *neighbour) {
+  if (city->index != NULL) {
+    return findInRoadsIndex(city->index, neighbour->id);
   }
 
   RoadsListNode *iter = city->roads->head->next;
   while (isValidRoadsListNode(iter)) {
     if (iter->elem.city == neighbour) {
-      return true;
+      return iter;
     }
     iter = iter->next;
   }
-  return false;
-}
-
-bool addRoadSection(Trie *city1, Trie *city2, unsigned length, int builtYear) {
-  return addRoadsListNode(city1->roads, city2, length, builtYear);
+  return NULL;
 }
 
-unsigned getRoadLength(Trie *city, Trie *neighbour) {
-  assert(isNeighbour(city, neighbour));
+// Tworzy indeks odcinków dróg miasta @p city.
+static bool buildRoadsIndex(Trie *city) {
+  RoadsIndex *index = newRoadsIndex();
+  if (index == NULL) {
+    return false;
+  }
 
   RoadsListNode *iter = city->roads->head->next;
   while (isValidRoadsListNode(iter)) {
-    if (iter->elem.city == neighbour) {
-      return iter->elem.length;
+    if (!insertIntoRoadsIndex(index, ((Trie *)iter->elem.city)->id, iter)) {
+      deleteRoadsIndex(index);
+      return false;
     }
     iter = iter->next;
   }
 
-  assert(false);
-  return 0;
+  city->index = index;
+  return true;
 }
 
-int getRepairYear(Trie *city, Trie *neighbour) {
-  assert(isNeighbour(city, neighbour));
+// Dodaje odcinek @p road do listy dróg miasta @p city.
+static bool attachRoad(Trie *city, Trie *neighbour, Road *road) {
+  if (!addRoadsListNode(city->roads, neighbour, road)) {
+    return false;
+  }
+  city->degree++;
 
-  RoadsListNode *iter = city->roads->head->next;
-  while (isValidRoadsListNode(iter)) {
-    if (iter->elem.city == neighbour) {
-      return iter->elem.builtYear;
+  if (city->index != NULL) {
+    if (!insertIntoRoadsIndex(city->index, neighbour->id,
+                              city->roads->tail->prev)) {
+      // bez indeksu wyszukiwanie odcinków wciąż działa, tylko wolniej
+      deleteRoadsIndex(city->index);
+      city->index = NULL;
     }
-    iter = iter->next;
+  } else if (city->degree > ROADS_INDEX_THRESHOLD) {
+    buildRoadsIndex(city);
   }
-
-  assert(false);
-  return 0;
+  return true;
 }
 
-void repairRoadSection(Trie *city, Trie *neighbour, int repairYear) {
-  RoadsListNode *iter = city->roads->head->next;
-  while (isValidRoadsListNode(iter)) {
-    if (iter->elem.city == neighbour) {
-      iter->elem.builtYear = repairYear;
-      return;
-    }
-    iter = iter->next;
+// Usuwa z listy dróg miasta @p city odcinek do miasta @p neighbour.
+static void detachRoad(Trie *city, Trie *neighbour) {
+  RoadsListNode *node = findRoadNode(city, neighbour);
+  assert(node);
+
+  if (city->index != NULL) {
+    removeFromRoadsIndex(city->index, neighbour->id);
+  }
+  removeRoadsListNode(city->roads, node);
+  city->degree--;
+
+  if (city->index != NULL && city->degree <= ROADS_INDEX_THRESHOLD / 2) {
+    deleteRoadsIndex(city->index);
+    city->index = NULL;
   }
-  assert(false);
 }
 
-RoadsListNode *getRoadBetweenCities(Trie *city, Trie *neighbour) {
-  assert(city);
-  assert(neighbour);
-  assert(isNeighbour(city, neighbour));
+bool isNeighbour(Trie *city, Trie *neighbour) {
+  if (city == NULL || neighbour == NULL) {
+    return false;
+  }
+  return findRoadNode(city, neighbour) != NULL;
+}
 
-  RoadsListNode *iter = city->roads->head->next;
-  assert(iter);
+bool addRoadSection(Trie *city1, Trie *city2, unsigned length, int builtYear) {
+  Road *road = newRoad(city1->roads->pools, length, builtYear);
+  if (road == NULL) {
+    return false;
+  }
 
-  while (isValidRoadsListNode(iter)) {
-    if (iter->elem.city == neighbour) {
-      return iter;
-    }
-    iter = iter->next;
+  if (!attachRoad(city1, city2, road)) {
+    deleteRoad(road);
+    return false;
   }
+  if (!attachRoad(city2, city1, road)) {
+    detachRoad(city1, city2);
+    return false;
+  }
+  return true;
+}
 
-  assert(false);
-  return NULL;
+void removeRoadSection(Trie *city1, Trie *city2) {
+  detachRoad(city1, city2);
+  detachRoad(city2, city1);
+}
+
+unsigned getRoadLength(Trie *city, Trie *neighbour) {
+  return getRoadBetweenCities(city, neighbour)->length;
+}
+
+int getRepairYear(Trie *city, Trie *neighbour) {
+  return getRoadBetweenCities(city, neighbour)->builtYear;
+}
+
+void repairRoadSection(Trie *city, Trie *neighbour, int repairYear) {
+  getRoadBetweenCities(city, neighbour)->builtYear = repairYear;
+}
+
+Road *getRoadBetweenCities(Trie *city, Trie *neighbour) {
+  assert(city);
+  assert(neighbour);
+
+  RoadsListNode *node = findRoadNode(city, neighbour);
+  assert(node);
+  return node->elem.road;
 }
@@ -7,34 +7,55 @@
 
 #include <stdbool.h>
 
-#include "children_list.h"
+#include "defines.h"
+#include "node_pool.h"
+#include "roads_index.h"
 #include "roads_list.h"
 
 /**
- * Struktura drzewa Trie przechowująca napisy, reprezentujące miasta.
+ * Dzieci węzła drzewa Trie o średniej liczbie dzieci.
+ */
+typedef struct TrieIndexedChildren {
+  unsigned char slots[TRIE_TABLE_SIZE];  ///< numer dziecka + 1 lub 0, gdy brak
+  struct Trie *children[TRIE_INDEXED_CHILDREN];  ///< dzieci węzła
+} TrieIndexedChildren;
+
+/**
+ * Skompresowane drzewo Trie przechowujące napisy, reprezentujące miasta.
+ * Krawędź prowadząca do węzła jest etykietowana niepustym napisem, a dzieci
+ * węzła są rozróżniane pierwszymi znakami swoich etykiet.
+ * Węzeł o co najwyżej @ref TRIE_INLINE_CHILDREN dzieciach przechowuje je
+ * w posortowanych według znaków tablicach @p keys i @p children. Węzeł
+ * o co najwyżej @ref TRIE_INDEXED_CHILDREN dzieciach przechowuje je
+ * w strukturze @p indexed, a węzeł o większej liczbie dzieci – w tablicy
+ * @p table, indeksowanej znakami. Listę odcinków dróg mają tylko węzły
+ * reprezentujące miasta.
  */
 typedef struct Trie {
-  ChildrenList *children;  ///< lista dzieci wierzchołka trie
-  bool isLeaf;             ///< informacja o tym, czy węzeł jest liściem
-  int id;                  ///< numer wierzchołka
-  RoadsList *roads;  ///< lista odcinków dróg, które wychodzą z danego miasta
-  char character;    ///< odpowiadający węzłowi znak
-  struct Trie *parent;  ///< przodek węzła
+  const char *label;  ///< napis na krawędzi od przodka do węzła
+  int labelLength;    ///< długość napisu @p label
+  int numOfChildren;  ///< liczba dzieci węzła
+  unsigned char keys[TRIE_INLINE_CHILDREN];     ///< znaki dzieci węzła
+  char inlineLabel[TRIE_INLINE_LABEL];          ///< miejsce na krótką etykietę
+  TrieIndexedChildren *indexed;  ///< dzieci węzła lub NULL
+  struct Trie **table;  ///< tablica dzieci indeksowana znakami lub NULL
+  struct Trie *children[TRIE_INLINE_CHILDREN];  ///< dzieci węzła
+  bool isLeaf;          ///< informacja o tym, czy węzeł jest liściem
+  int id;               ///< numer wierzchołka
+  RoadsList *roads;  ///< lista odcinków dróg lub NULL, gdy to nie miasto
+  int degree;        ///< liczba odcinków dróg, które wychodzą z danego miasta
+  RoadsIndex *index;  ///< indeks odcinków dróg lub NULL dla małego stopnia
 } Trie;
 
 /** @brief Tworzy nową strukturę.
- * Tworzy nowy wierzchołek drzewa Trie.
+ * Tworzy nowy wierzchołek drzewa Trie, który nie ma dzieci i nie jest
+ * miastem. Wierzchołek jest przydzielany z pul @p pools i jest zwalniany
+ * razem z nimi.
+ * @param[in] pools – wskaźnik na pule węzłów.
  * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
  * zaalokować pamięci.
  */
-Trie *newTrieNode();
-
-/** @brief Usuwa strukturę.
- * Usuwa strukturę wskazywaną przez @p node.
- * Nic nie robi, jeśli wskaźnik ten ma wartość NULL.
- * @param[in] node – wskaźnik na usuwaną strukturę.
- */
-void deleteTrie(Trie *node);
+Trie *newTrieNode(NodePools *pools);
 
 /** @brief Zwraca wskaźnik do węzła reprezentującego miasto.
  * Jeśli miasto istnieje, zwraca do niego wskaźnik;
@@ -47,16 +68,19 @@ Trie *getNodePtr(Trie *root, const char *city);
 
 /** @brief Dodaje do drzewa Trie nowe miasto.
  * Jeśli miasto już istnieje, nic nie robi.
+ * @param[in] pools – wskaźnik na pule węzłów;
  * @param[in,out] root – wskaźnik na korzeń Trie;
  * @param[in] city – wskaźnik na napis reprezentujący nazwę miasta;
  * @param[in] id – numer miasta.
- * @return Wartość @p true, jeśli miasto zostało dodane.
- * Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ * @return Wskaźnik na węzeł reprezentujący miasto lub NULL, jeśli nie udało
+ * się zaalokować pamięci.
  */
-bool insertStr(Trie *root, const char *city, int id);
+Trie *insertStr(NodePools *pools, Trie *root, const char *city, int id);
 
 /** @brief Sprawdza czy miasta są sąsiadami.
  * Sprawdza, czy @p neighbour występuje wśród sąsiadów @p city.
+ * Miasta o stopniu większym niż @ref ROADS_INDEX_THRESHOLD mają indeks
+ * odcinków dróg, więc sprawdzenie działa w oczekiwanym czasie stałym.
  * @param[in] city – wskaźnik na miasto.
  * @param[in] neighbour - wskaźnik na miasto sąsiednie.
  * @return Wartość @p true, jeśli @p neighbour jest sąsiadem @p city.
@@ -65,19 +89,25 @@ bool insertStr(Trie *root, const char *city, int id);
 bool isNeighbour(Trie *city, Trie *neighbour);
 
 /** @brief Dodaje drogę pomiędzy @p city1 a @p city2.
- * Jeśli któreś z podanych miast nie istnieje, to dodaje go do mapy, a następnie
- * dodaje do mapy odcinek drogi między tymi miastami.
- * @param[in] city1      – wskaźnik na napis reprezentujący nazwę miasta;
- * @param[in] city2      – wskaźnik na napis reprezentujący nazwę miasta;
+ * Tworzy jeden odcinek drogi i dodaje go do list dróg obu miast.
+ * Miasta nie mogą ze sobą sąsiadować.
+ * @param[in,out] city1  – wskaźnik na pierwsze miasto;
+ * @param[in,out] city2  – wskaźnik na drugie miasto;
  * @param[in] length     – długość w km odcinka drogi;
  * @param[in] builtYear  – rok budowy odcinka drogi.
- * @return Wartość wynik funkcji @ref addRoadsListNode
- * Wartość @p false, jeśli wystąpił błąd: któryś z parametrów ma niepoprawną
- * wartość, obie podane nazwy miast są identyczne, odcinek drogi między tymi
- * miastami już istnieje lub nie udało się zaalokować pamięci.
+ * @return Wartość @p true, jeśli odcinek drogi został dodany.
+ * Wartość @p false, jeśli nie udało się zaalokować pamięci.
  */
 bool addRoadSection(Trie *city1, Trie *city2, unsigned length, int builtYear);
 
+/** @brief Usuwa drogę pomiędzy @p city1 a @p city2.
+ * Usuwa odcinek drogi z list dróg obu miast. Oba miasta muszą ze sobą
+ * sąsiadować.
+ * @param[in,out] city1 – wskaźnik na pierwsze miasto;
+ * @param[in,out] city2 – wskaźnik na drugie miasto.
+ */
+void removeRoadSection(Trie *city1, Trie *city2);
+
 /** @brief Zwraca rok budowy lub naprawy odcinka drogi między
  * @p city a @p neighbour. Oba miasta muszą ze sobą sąsiadować.
  * @param[in] city  – wskaźnik na pierwsze miasto.
@@ -94,9 +124,9 @@ int getRepairYear(Trie *city, Trie *neighbour);
  */
 unsigned getRoadLength(Trie *city, Trie *neighbour);
 
-/** @brief Zmienia wartość repairYear w liście dróg miasta city.
- * Oba miasta muszą ze sobą sąsiadować. Nie zmienia wartości
- * repairYear w liście dróg miasta neighbour.
+/** @brief Zmienia rok remontu odcinka drogi między miastami.
+ * Oba miasta muszą ze sobą sąsiadować. Odcinek jest wspólny dla obu miast,
+ * więc zmiana jest widoczna z obu stron.
  * @param[in] city  – wskaźnik na pierwsze miasto.
  * @param[in] neighbour - wskaźnik na drugie miasto.
  * @param[in] repairYear - rok budowy lub remontu
@@ -108,8 +138,8 @@ void repairRoadSection(Trie *city, Trie *neighbour, int repairYear);
  * Miasto @p city musi mieć miasto @p neighbor jako sąsiada.
  * @param[in] city - wskaźnik na miasto
  * @param[in] neighbour – wskaźnik na sąsiada.
- * @return Wskaźnik do drogi między tymi miastami.
+ * @return Wskaźnik do odcinka drogi między tymi miastami.
  */
-RoadsListNode *getRoadBetweenCities(Trie *city, Trie *neighbour);
+Road *getRoadBetweenCities(Trie *city, Trie *neighbour);
 
 #endif  // __TRIE_H__